@@ -246,4 +246,71 @@ CircBuff_PeekLast(CircBuff_t* Buff, uint8_t * Data)
   return r;
 }
 
+/*********************************************************************
+* Function : CircBuff_GetCount()
+*//**
+* \b Description:
+*
+* This function is used to get the number of bytes stored in a circuler
+* buffer
+*
+* @param Buff a valid pointer to the circuler buffer
+* @return uint8_t the number of stored bytes, 0 if the pointer is invalid.
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* CircBuff_Enqueue(&UartBuff, 'a');
+* uint8_t n = CircBuff_GetCount(&UartBuff); // n is 1
+* @endcode
+*
+* @see CircBuff_GetFree
+**********************************************************************/
+extern uint8_t
+CircBuff_GetCount(const CircBuff_t* Buff)
+{
+  uint8_t r = 0;
+
+  if(Buff != NULL)
+    {
+      r = (uint8_t)((Buff->Front + Buff->Size - Buff->Rear) % Buff->Size);
+    }
+
+  return r;
+}
+
+/*********************************************************************
+* Function : CircBuff_GetFree()
+*//**
+* \b Description:
+*
+* This function is used to get the number of bytes that can still be
+* enqueued into a circuler buffer
+*
+* @param Buff a valid pointer to the circuler buffer
+* @return uint8_t the number of free bytes, 0 if the pointer is invalid.
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* uint8_t n = CircBuff_GetFree(&UartBuff); // n is MAX_UART_BUFF_SIZE - 1
+* @endcode
+*
+* @see CircBuff_GetCount
+**********************************************************************/
+extern uint8_t
+CircBuff_GetFree(const CircBuff_t* Buff)
+{
+  uint8_t r = 0;
+
+  if(Buff != NULL)
+    {
+      r = (uint8_t)(Buff->Size - 1 - CircBuff_GetCount(Buff));
+    }
+
+  return r;
+}
+
 /************************End Of File ******************************/
\ No newline at end of file
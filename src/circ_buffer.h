@@ -38,6 +38,8 @@ extern void CircBuff_Reset(CircBuff_t* Buff);
 extern uint8_t CircBuff_Dequeue(CircBuff_t* Buff, uint8_t * Data);
 extern uint8_t CircBuff_Enqueue(CircBuff_t* Buff, uint8_t Data);
 extern uint8_t CircBuff_PeekLast(CircBuff_t* Buff, uint8_t * Data);
+extern uint8_t CircBuff_GetCount(const CircBuff_t* Buff);
+extern uint8_t CircBuff_GetFree(const CircBuff_t* Buff);
 
 #endif /* end CIRC_BUFFER_H */
 /************************End Of File ******************************/
\ No newline at end of file
@@ -56,6 +56,8 @@ typedef enum
 	PORTA_3,
 	PORTA_4,
 	PORTA_5,
+	PORTA_6,
+	PORTA_7,
 	DIO_CHANNEL_MAX
 }DioChannel_t;
 
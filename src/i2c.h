@@ -0,0 +1,35 @@
+/**
+ * @file i2c.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the i2c.
+ * This is the header file for the definition of the interface for an i2c
+ * master peripheral on a standard microcontroller.
+ * @version 0.1
+ * @date 2021-04-10
+*/
+#ifndef I2C_H_
+#define I2C_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * Writes Size bytes to the slave of the 7-bit Address in one transaction
+ * (start, address, data, stop). It returns 1 if the slave acknowledged.
+ */
+extern uint8_t I2c_Write(uint8_t Address, const uint8_t* const Data,
+                         uint8_t Size);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* I2C_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,107 @@
+/**
+ * @file i2c_stub.c
+ * @author Mohamed Hassanin
+ * @brief A host stub of the i2c interface. It records the transactions
+ * instead of driving a bus so that the bytes on the wire can be measured.
+ * @version 0.1
+ * @date 2021-04-10
+*/
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include "i2c_stub.h"
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The statistics of the recorded transactions
+*/
+static I2cStubStats_t gStats;
+
+/**
+* The callback of the transactions, 0 for none
+*/
+static I2cStubHook_t gHook;
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : I2c_Write()
+*//**
+* \b Description: Records a transaction instead of sending it<br/>
+* @param Address the 7-bit address of the slave
+* @param Data a pointer to the bytes to write
+* @param Size the number of bytes
+* @return uint8_t 1 always (the stub slave always acknowledges)
+**********************************************************************/
+extern uint8_t
+I2c_Write(uint8_t Address, const uint8_t* const Data, uint8_t Size)
+{
+	uint8_t i;
+
+	gStats.Transactions++;
+	gStats.Bytes += (uint32_t)Size + 1U;
+	gStats.LastAddress = Address;
+	gStats.LastSize = Size;
+
+	for(i = 0; i < Size && i < I2C_STUB_LAST_SIZE; i++)
+	{
+		gStats.Last[i] = Data[i];
+	}
+
+	if(gHook != 0x00)
+	{
+		gHook(Address, Data, Size);
+	}
+
+	return 1;
+}
+
+/**********************************************************************
+* Function : I2cStub_Reset()
+*//**
+* \b Description: Clears the recorded statistics<br/>
+* @return void
+**********************************************************************/
+extern void
+I2cStub_Reset(void)
+{
+	gStats.Transactions = 0;
+	gStats.Bytes = 0;
+	gStats.LastAddress = 0;
+	gStats.LastSize = 0;
+}
+
+/**********************************************************************
+* Function : I2cStub_GetStats()
+*//**
+* \b Description: Returns the recorded statistics<br/>
+* @return const I2cStubStats_t* a pointer to the statistics
+*
+* \b Example:
+* @code
+* I2cStub_Reset();
+* ... draw a screen and run LcdDisplay_Update until it's idle ...
+* printf("%lu bytes\n", (unsigned long)I2cStub_GetStats()->Bytes);
+* @endcode
+**********************************************************************/
+extern const I2cStubStats_t*
+I2cStub_GetStats(void)
+{
+	return &gStats;
+}
+
+/**********************************************************************
+* Function : I2cStub_SetHook()
+*//**
+* \b Description: Sets the callback invoked with the bytes of each
+* transaction, e.g. to decode them<br/>
+* @param Hook the callback, 0 for none
+* @return void
+**********************************************************************/
+extern void
+I2cStub_SetHook(const I2cStubHook_t Hook)
+{
+	gHook = Hook;
+}
+/*************** END OF FILE ********************************/
@@ -0,0 +1,59 @@
+/**
+ * @file i2c_stub.h
+ * @author Mohamed Hassanin
+ * @brief A host stub of the i2c interface. It records the transactions
+ * instead of driving a bus so that the bytes on the wire can be measured.
+ * @version 0.1
+ * @date 2021-04-10
+*/
+#ifndef I2C_STUB_H_
+#define I2C_STUB_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "i2c.h"
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the maximum number of bytes kept of the last transaction.
+*/
+#define I2C_STUB_LAST_SIZE 64U
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the statistics recorded by the stub.
+*/
+typedef struct
+{
+	uint32_t Transactions; /**< the number of transactions */
+	uint32_t Bytes; /**< the bytes on the wire including the address bytes */
+	uint8_t LastAddress; /**< the address of the last transaction */
+	uint8_t LastSize; /**< the size of the last transaction */
+	uint8_t Last[I2C_STUB_LAST_SIZE]; /**< the first bytes of the last one */
+}I2cStubStats_t;
+
+/**
+* Defines a callback invoked with the bytes of each transaction.
+*/
+typedef void (*I2cStubHook_t)(uint8_t Address, const uint8_t* const Data,
+ uint8_t Size);
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern void I2cStub_Reset(void);
+extern const I2cStubStats_t* I2cStub_GetStats(void);
+extern void I2cStub_SetHook(const I2cStubHook_t Hook);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* I2C_STUB_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,556 @@
+/**
+ * @file lcd_charset.c
+ * @author Mohamed Hassanin
+ * @brief The character sets of the LCD display module. The decoder and the
+ * mappings are driven by constant tables: one load per character for
+ * ASCII and Latin-1 and a binary search for the other symbols.
+ * @version 0.1
+ * @date 2021-04-18
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lcd_display_cfg.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/**
+ * The first code point of the Latin-1 tables (the control codes below it
+ * are passed through so that text can embed the CGRAM characters)
+ */
+#define LCD_CHARSET_LATIN1_FIRST 0x20
+
+/**
+ * The ranges of the kana tables of the A00 ROM
+ */
+#define LCD_CHARSET_HALFWIDTH_FIRST 0xFF61UL /**< halfwidth katakana */
+#define LCD_CHARSET_HALFWIDTH_LAST 0xFF9FUL
+#define LCD_CHARSET_HALFWIDTH_CODE 0xA1 /**< ROM code of the first one */
+#define LCD_CHARSET_HIRAGANA_FIRST 0x3041UL
+#define LCD_CHARSET_HIRAGANA_LAST 0x3096UL
+#define LCD_CHARSET_HIRAGANA_SHIFT 0x60 /**< from hiragana to katakana */
+#define LCD_CHARSET_KATAKANA_FIRST 0x30A1UL
+#define LCD_CHARSET_KATAKANA_LAST 0x30FCUL
+
+/**
+ * An entry of the katakana table holds the ROM code minus 0xA0 in its 6
+ * low bits and the sound mark (1 voiced, 2 semi-voiced) in its 2 high bits.
+ */
+#define LCD_CHARSET_KANA_BASE 0xA0
+#define LCD_CHARSET_KANA_CODE 0x3F
+#define LCD_CHARSET_KANA_MARK_SHIFT 6
+#define LCD_CHARSET_KANA_MARK_BASE 0xDD /**< + 1 voiced, + 2 semi-voiced */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * A structure for a symbol of a ROM outside Latin-1
+ */
+typedef struct
+{
+  uint16_t CodePoint;
+  uint8_t Code;
+} LcdSymbol_t;
+/******************************************************************************
+ * Functions Prototypes
+ ******************************************************************************/
+static uint8_t LcdCharset_Search(const LcdSymbol_t* const Symbols,
+ uint8_t Count, uint32_t CodePoint, uint8_t* const Codes);
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the length of a UTF-8 sequence from the 5 high bits of its first
+ * byte. 0 for a continuation byte or an invalid byte.
+ */
+static const uint8_t gUtf8Length[32] =
+{
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 0x00 - 0x7F */
+  0, 0, 0, 0, 0, 0, 0, 0,                         /* 0x80 - 0xBF */
+  2, 2, 2, 2,                                     /* 0xC0 - 0xDF */
+  3, 3,                                           /* 0xE0 - 0xEF */
+  4,                                              /* 0xF0 - 0xF7 */
+  0                                               /* 0xF8 - 0xFF */
+};
+
+/**
+ * @brief the payload bits of the first byte of a sequence of each length
+ */
+static const uint8_t gUtf8Mask[5] = {0x00, 0x7F, 0x1F, 0x0F, 0x07};
+
+/**
+ * @brief the smallest code point of a sequence of each length (the longer
+ * encodings of a code point are invalid)
+ */
+static const uint32_t gUtf8Min[5] = {0, 0, 0x80, 0x800, 0x10000};
+
+/**
+ * @brief the ROM code of the Latin-1 code points (from U+0020) of each ROM,
+ * 0 if the ROM has no glyph for it
+ */
+static const uint8_t gLatin1[LCD_ROM_MAX][256 - LCD_CHARSET_LATIN1_FIRST] =
+{
+  {
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,  /* U+0020 */
+    0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,  /* U+0030 */
+    0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,  /* U+0040 */
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,  /* U+0050 */
+    0x58, 0x59, 0x5A, 0x5B, 0x00, 0x5D, 0x5E, 0x5F,  /* 0x5C is yen */
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,  /* U+0060 */
+    0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,  /* U+0070 */
+    0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x00, 0x00,  /* 0x7E/0x7F arrows */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* U+0080 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* U+0090 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0xEC, 0x00, 0x00, 0x5C, 0x00, 0x00,  /* U+00A0 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xDF, 0x00, 0x00, 0x00, 0x00, 0xE4, 0x00, 0xA5,  /* U+00B0 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* U+00C0 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* U+00D0 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE2,  /* sharp s as beta */
+    0x00, 0x00, 0x00, 0x00, 0xE1, 0x00, 0x00, 0x00,  /* U+00E0 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xEE, 0x00, 0x00, 0x00, 0x00, 0xEF, 0xFD,  /* U+00F0 */
+    0x00, 0x00, 0x00, 0x00, 0xF5, 0x00, 0x00, 0x00
+  },
+  {
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,  /* U+0020 */
+    0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,  /* U+0030 */
+    0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,  /* U+0040 */
+    0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,  /* U+0050 */
+    0x58, 0x59, 0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,  /* U+0060 */
+    0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,  /* U+0070 */
+    0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* U+0080 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* U+0090 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,  /* U+00A0 */
+    0x00, 0xA9, 0xAA, 0xAB, 0x00, 0x00, 0xAE, 0x00,
+    0xB0, 0xB1, 0xB2, 0xB3, 0x00, 0xB5, 0xB6, 0xB7,  /* U+00B0 */
+    0x00, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+    0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,  /* U+00C0 */
+    0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+    0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,  /* U+00D0 */
+    0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7,  /* U+00E0 */
+    0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7,  /* U+00F0 */
+    0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
+  }
+};
+
+/**
+ * @brief the halfwidth katakana of the A00 ROM of the katakana from U+30A1
+ * to U+30FC (see LCD_CHARSET_KANA_CODE), 0 if there's none. The voiced
+ * kana are shown as the base kana followed by the sound mark.
+ */
+static const uint8_t gKana[LCD_CHARSET_KATAKANA_LAST -
+ LCD_CHARSET_KATAKANA_FIRST + 1] =
+{
+  0x07, 0x11, 0x08, 0x12, 0x09, 0x13, 0x0A, 0x14, 0x0B, 0x15, 0x16, 0x56,
+  0x17, 0x57, 0x18, 0x58, 0x19, 0x59, 0x1A, 0x5A, 0x1B, 0x5B, 0x1C, 0x5C,
+  0x1D, 0x5D, 0x1E, 0x5E, 0x1F, 0x5F, 0x20, 0x60, 0x21, 0x61, 0x0F, 0x22,
+  0x62, 0x23, 0x63, 0x24, 0x64, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x6A,
+  0xAA, 0x2B, 0x6B, 0xAB, 0x2C, 0x6C, 0xAC, 0x2D, 0x6D, 0xAD, 0x2E, 0x6E,
+  0xAE, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x0C, 0x34, 0x0D, 0x35, 0x0E, 0x36,
+  0x37, 0x38, 0x39, 0x3A, 0x3B, 0x00, 0x3C, 0x00, 0x00, 0x06, 0x3D, 0x53,
+  0x00, 0x00, 0x7C, 0x00, 0x00, 0x46, 0x05, 0x10
+};
+
+/**
+ * @brief the other symbols of the A00 ROM sorted by code point
+ */
+static const LcdSymbol_t gSymbolsA00[] =
+{
+  {0x03A3, 0xF6}, /* capital sigma */
+  {0x03A9, 0xF4}, /* capital omega */
+  {0x03B1, 0xE0}, /* alpha */
+  {0x03B2, 0xE2}, /* beta */
+  {0x03B5, 0xE3}, /* epsilon */
+  {0x03B8, 0xF2}, /* theta */
+  {0x03BC, 0xE4}, /* mu */
+  {0x03C0, 0xF7}, /* pi */
+  {0x03C1, 0xE6}, /* rho */
+  {0x03C3, 0xE5}, /* sigma */
+  {0x2190, 0x7F}, /* leftwards arrow */
+  {0x2192, 0x7E}, /* rightwards arrow */
+  {0x221A, 0xE8}, /* square root */
+  {0x221E, 0xF3}, /* infinity */
+  {0x2588, 0xFF}, /* full block */
+  {0x3001, 0xA4}, /* ideographic comma */
+  {0x3002, 0xA1}, /* ideographic full stop */
+  {0x300C, 0xA2}, /* left corner bracket */
+  {0x300D, 0xA3}, /* right corner bracket */
+  {0x309B, 0xDE}, /* voiced sound mark */
+  {0x309C, 0xDF}, /* semi-voiced sound mark */
+  {0x4E07, 0xFB}, /* ten thousand */
+  {0x5186, 0xFC}, /* yen */
+  {0x5343, 0xFA}  /* thousand */
+};
+
+/**
+ * @brief the other symbols of the A02 ROM sorted by code point. The
+ * Cyrillic letters that look like Latin ones use the Latin glyphs.
+ */
+static const LcdSymbol_t gSymbolsA02[] =
+{
+  {0x0192, 0xA8}, /* f with hook */
+  {0x0393, 0x92}, /* capital gamma */
+  {0x0398, 0x99}, /* capital theta */
+  {0x03A3, 0x94}, /* capital sigma */
+  {0x03A9, 0x9A}, /* capital omega */
+  {0x03B1, 0x90}, /* alpha */
+  {0x03B4, 0x9B}, /* delta */
+  {0x03B5, 0x9E}, /* epsilon */
+  {0x03C0, 0x93}, /* pi */
+  {0x03C3, 0x95}, /* sigma */
+  {0x03C4, 0x97}, /* tau */
+  {0x03C9, 0xB8}, /* omega */
+  {0x0401, 0xCB}, /* IO */
+  {0x0410, 0x41}, /* A */
+  {0x0411, 0x80}, /* BE */
+  {0x0412, 0x42}, /* VE */
+  {0x0414, 0x81}, /* DE */
+  {0x0415, 0x45}, /* IE */
+  {0x0416, 0x82}, /* ZHE */
+  {0x0417, 0x83}, /* ZE */
+  {0x0418, 0x84}, /* I */
+  {0x0419, 0x85}, /* SHORT I */
+  {0x041A, 0x4B}, /* KA */
+  {0x041B, 0x86}, /* EL */
+  {0x041C, 0x4D}, /* EM */
+  {0x041D, 0x48}, /* EN */
+  {0x041E, 0x4F}, /* O */
+  {0x041F, 0x87}, /* PE */
+  {0x0420, 0x50}, /* ER */
+  {0x0421, 0x43}, /* ES */
+  {0x0422, 0x54}, /* TE */
+  {0x0423, 0x88}, /* U */
+  {0x0425, 0x58}, /* HA */
+  {0x0426, 0x89}, /* TSE */
+  {0x0427, 0x8A}, /* CHE */
+  {0x0428, 0x8B}, /* SHA */
+  {0x0429, 0x8C}, /* SHCHA */
+  {0x042A, 0x8D}, /* HARD SIGN */
+  {0x042B, 0x8E}, /* YERU */
+  {0x042D, 0x8F}, /* E */
+  {0x042E, 0xAC}, /* YU */
+  {0x042F, 0xAD}, /* YA */
+  {0x201C, 0x12}, /* left double quotation mark */
+  {0x201D, 0x13}, /* right double quotation mark */
+  {0x2190, 0x1B}, /* leftwards arrow */
+  {0x2191, 0x18}, /* upwards arrow */
+  {0x2192, 0x1A}, /* rightwards arrow */
+  {0x2193, 0x19}, /* downwards arrow */
+  {0x21B5, 0x17}, /* return */
+  {0x221E, 0x9C}, /* infinity */
+  {0x2229, 0x9F}, /* intersection */
+  {0x2264, 0x1C}, /* less-than or equal to */
+  {0x2265, 0x1D}, /* greater-than or equal to */
+  {0x25B2, 0x1E}, /* up-pointing triangle */
+  {0x25B6, 0x10}, /* right-pointing triangle */
+  {0x25BC, 0x1F}, /* down-pointing triangle */
+  {0x25C0, 0x11}, /* left-pointing triangle */
+  {0x25CF, 0x16}, /* black circle */
+  {0x2665, 0x9D}, /* heart */
+  {0x266A, 0x91}, /* eighth note */
+  {0x266C, 0x96}  /* beamed sixteenth notes */
+};
+
+/**
+ * @brief the symbols of each ROM and their number
+ */
+static const LcdSymbol_t* const gSymbols[LCD_ROM_MAX] =
+{
+  gSymbolsA00,
+  gSymbolsA02
+};
+
+static const uint8_t gSymbolCount[LCD_ROM_MAX] =
+{
+  sizeof(gSymbolsA00) / sizeof(gSymbolsA00[0]),
+  sizeof(gSymbolsA02) / sizeof(gSymbolsA02[0])
+};
+
+/**
+ * @brief the built-in glyphs of the characters that the A00 ROM lacks
+ */
+static const uint8_t gGlyphAUmlaut[LCD_CHARSET_GLYPH_ROWS] =
+ {0x0A, 0x00, 0x0E, 0x11, 0x1F, 0x11, 0x11};
+static const uint8_t gGlyphOUmlaut[LCD_CHARSET_GLYPH_ROWS] =
+ {0x0A, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E};
+static const uint8_t gGlyphUUmlaut[LCD_CHARSET_GLYPH_ROWS] =
+ {0x0A, 0x00, 0x11, 0x11, 0x11, 0x11, 0x0E};
+static const uint8_t gGlyphBackslash[LCD_CHARSET_GLYPH_ROWS] =
+ {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00};
+static const uint8_t gGlyphTilde[LCD_CHARSET_GLYPH_ROWS] =
+ {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00};
+
+static const LcdGlyph_t gBuiltinGlyphs[] =
+{
+  {0x005C, gGlyphBackslash},
+  {0x007E, gGlyphTilde},
+  {0x00C4, gGlyphAUmlaut},
+  {0x00D6, gGlyphOUmlaut},
+  {0x00DC, gGlyphUUmlaut}
+};
+
+/**
+ * @brief the glyphs registered by LcdCharset_AddGlyph
+ */
+static LcdGlyph_t gGlyphs[LCD_CHARSET_GLYPH_MAX];
+
+/**
+ * @brief the number of glyphs in gGlyphs
+ */
+static uint8_t gGlyphCount;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdCharset_Decode()
+*//**
+* \b Description: Decode the next code point of a UTF-8 text. An invalid or
+* truncated sequence gives LCD_CHARSET_INVALID.<br/>
+* \b PRE-CONDITION: TextSize is at least 1 <br/>
+* @param Text A pointer to the text.
+* @param TextSize The number of bytes of the text.
+* @param CodePoint A pointer to the decoded code point.
+* @return uint8_t the number of bytes of the text used (at least 1)
+******************************************************************************/
+extern uint8_t
+LcdCharset_Decode(const uint8_t* const Text, const uint8_t TextSize,
+ uint32_t* const CodePoint)
+{
+  if(!(Text != 0x00 && TextSize != 0 && CodePoint != 0x00))
+    {
+      //TODO: handle this error
+      return 1;
+    }
+
+  const uint8_t Length = gUtf8Length[Text[0] >> 3];
+  uint32_t Value = Text[0] & gUtf8Mask[Length];
+  uint8_t i;
+
+  *CodePoint = LCD_CHARSET_INVALID;
+
+  if(Length == 0) return 1;
+
+  for(i = 1; i < Length; i++)
+    {
+      if(i == TextSize || (Text[i] & 0xC0) != 0x80) return i;
+
+      Value = (Value << 6) | (Text[i] & 0x3F);
+    }
+
+  //overlong encodings and surrogates aren't valid code points
+  if(Value >= gUtf8Min[Length] && (Value & 0xFFFFF800UL) != 0xD800 &&
+     Value <= 0x10FFFFUL)
+    {
+      *CodePoint = Value;
+    }
+
+  return Length;
+}
+
+/******************************************************************************
+* Function : LcdCharset_Map()
+*//**
+* \b Description: Map a code point to the codes of a character ROM. The
+* control codes (below U+0020) are passed through so that the CGRAM
+* characters can be embedded in a text.<br/>
+* @param Rom The character ROM.
+* @param CodePoint The code point.
+* @param Codes A pointer to LCD_CHARSET_CODES_MAX bytes for the codes.
+* @return uint8_t the number of codes, 0 if the ROM has no glyph for it
+******************************************************************************/
+extern uint8_t
+LcdCharset_Map(const LcdRom_t Rom, const uint32_t CodePoint,
+ uint8_t* const Codes)
+{
+  if(!(Rom < LCD_ROM_MAX && Codes != 0x00))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint32_t Kana = CodePoint;
+  uint8_t Entry;
+
+  if(CodePoint < LCD_CHARSET_LATIN1_FIRST)
+    {
+      Codes[0] = (uint8_t)CodePoint;
+      return 1;
+    }
+
+  if(CodePoint < 0x100)
+    {
+      Codes[0] = gLatin1[Rom][CodePoint - LCD_CHARSET_LATIN1_FIRST];
+      return Codes[0] != 0;
+    }
+
+  if(Rom == LCD_ROM_A00)
+    {
+      if(CodePoint >= LCD_CHARSET_HALFWIDTH_FIRST &&
+         CodePoint <= LCD_CHARSET_HALFWIDTH_LAST)
+        {
+          Codes[0] = (uint8_t)(LCD_CHARSET_HALFWIDTH_CODE +
+           (CodePoint - LCD_CHARSET_HALFWIDTH_FIRST));
+          return 1;
+        }
+
+      //the ROM has no hiragana, the katakana is shown instead
+      if(Kana >= LCD_CHARSET_HIRAGANA_FIRST &&
+         Kana <= LCD_CHARSET_HIRAGANA_LAST)
+        {
+          Kana += LCD_CHARSET_HIRAGANA_SHIFT;
+        }
+
+      if(Kana >= LCD_CHARSET_KATAKANA_FIRST &&
+         Kana <= LCD_CHARSET_KATAKANA_LAST)
+        {
+          Entry = gKana[Kana - LCD_CHARSET_KATAKANA_FIRST];
+
+          if(Entry != 0)
+            {
+              Codes[0] = LCD_CHARSET_KANA_BASE +
+               (Entry & LCD_CHARSET_KANA_CODE);
+              Codes[1] = LCD_CHARSET_KANA_MARK_BASE +
+               (Entry >> LCD_CHARSET_KANA_MARK_SHIFT);
+
+              return 1 + ((Entry >> LCD_CHARSET_KANA_MARK_SHIFT) != 0);
+            }
+        }
+    }
+
+  return LcdCharset_Search(gSymbols[Rom], gSymbolCount[Rom], CodePoint, Codes);
+}
+
+/******************************************************************************
+* Function : LcdCharset_Search()
+*//**
+* \b Description: Utility function to find a code point in a sorted symbol
+* table<br/>
+* @param Symbols A pointer to the symbol table.
+* @param Count The number of symbols.
+* @param CodePoint The code point.
+* @param Codes A pointer to the code.
+* @return uint8_t 1 if it's found, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdCharset_Search(const LcdSymbol_t* const Symbols, uint8_t Count,
+ uint32_t CodePoint, uint8_t* const Codes)
+{
+  uint8_t Low = 0;
+  uint8_t High = Count;
+  uint8_t Mid;
+
+  while(Low < High)
+    {
+      Mid = (uint8_t)((Low + High) / 2);
+
+      if(Symbols[Mid].CodePoint < CodePoint)
+        {
+          Low = Mid + 1;
+        }
+      else
+        {
+          High = Mid;
+        }
+    }
+
+  if(Low < Count && Symbols[Low].CodePoint == CodePoint)
+    {
+      Codes[0] = Symbols[Low].Code;
+      return 1;
+    }
+
+  return 0;
+}
+
+/******************************************************************************
+* Function : LcdCharset_AddGlyph()
+*//**
+* \b Description: Register the CGRAM glyph of a code point that a character
+* ROM lacks. It replaces the glyph of the code point if there's one
+* (including a built-in one).<br/>
+* @param CodePoint The code point.
+* @param Bitmap A pointer to LCD_CHARSET_GLYPH_ROWS rows of 5 bits. It must
+* stay valid.
+* @return uint8_t 1 if the glyph is registered, 0 otherwise (no free entry)
+******************************************************************************/
+extern uint8_t
+LcdCharset_AddGlyph(const uint32_t CodePoint, const uint8_t* const Bitmap)
+{
+  if(!(Bitmap != 0x00 && CodePoint >= LCD_CHARSET_LATIN1_FIRST))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint8_t Glyph;
+
+  for(Glyph = 0; Glyph < gGlyphCount; Glyph++)
+    {
+      if(gGlyphs[Glyph].CodePoint == CodePoint)
+        {
+          gGlyphs[Glyph].Bitmap = Bitmap;
+          return 1;
+        }
+    }
+
+  if(gGlyphCount == LCD_CHARSET_GLYPH_MAX) return 0;
+
+  gGlyphs[gGlyphCount].CodePoint = CodePoint;
+  gGlyphs[gGlyphCount].Bitmap = Bitmap;
+  gGlyphCount++;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdCharset_FindGlyph()
+*//**
+* \b Description: Find the CGRAM glyph of a code point, the registered ones
+* first then the built-in ones<br/>
+* @param CodePoint The code point.
+* @return const uint8_t* the bitmap of the glyph, 0 if there's none
+******************************************************************************/
+extern const uint8_t*
+LcdCharset_FindGlyph(const uint32_t CodePoint)
+{
+  uint8_t Glyph;
+
+  for(Glyph = 0; Glyph < gGlyphCount; Glyph++)
+    {
+      if(gGlyphs[Glyph].CodePoint == CodePoint)
+        {
+          return gGlyphs[Glyph].Bitmap;
+        }
+    }
+
+  for(Glyph = 0; Glyph < sizeof(gBuiltinGlyphs) / sizeof(gBuiltinGlyphs[0]);
+      Glyph++)
+    {
+      if(gBuiltinGlyphs[Glyph].CodePoint == CodePoint)
+        {
+          return gBuiltinGlyphs[Glyph].Bitmap;
+        }
+    }
+
+  return 0x00;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,80 @@
+/**
+ * @file lcd_charset.h
+ * @author Mohamed Hassanin Mohamed
+ * @brief The character sets of the LCD display module: a UTF-8 decoder,
+ * the mapping of code points to the codes of the HD44780 character ROMs
+ * (A00 Japanese and A02 European) and a registry of CGRAM glyphs for the
+ * code points that the ROM doesn't have.
+ * @version 0.1
+ * @date 2021-04-18
+ */
+#ifndef LCD_CHARSET
+#define LCD_CHARSET
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/**
+ * @brief the code point of an invalid UTF-8 sequence (replacement character)
+ */
+#define LCD_CHARSET_INVALID 0xFFFDUL
+
+/**
+ * @brief the rows of a glyph bitmap (the last row of a character is
+ * reserved for the cursor)
+ */
+#define LCD_CHARSET_GLYPH_ROWS 7
+
+/**
+ * @brief the maximum number of ROM codes of a code point (a kana with a
+ * voiced sound mark takes two)
+ */
+#define LCD_CHARSET_CODES_MAX 2
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * Defines an enumerated list of the character ROMs of the HD44780
+ */
+typedef enum
+{
+  LCD_ROM_A00, /**< Japanese: ASCII, katakana and some symbols */
+  LCD_ROM_A02, /**< European: ASCII, Latin-1, some Cyrillic and Greek */
+  LCD_ROM_MAX
+} LcdRom_t;
+
+/**
+ * A structure for a CGRAM glyph of a code point
+ */
+typedef struct
+{
+  uint32_t CodePoint;
+  const uint8_t* Bitmap; /**< LCD_CHARSET_GLYPH_ROWS rows of 5 bits */
+} LcdGlyph_t;
+
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern uint8_t LcdCharset_Decode(const uint8_t* const Text,
+                                 const uint8_t TextSize,
+                                 uint32_t* const CodePoint);
+extern uint8_t LcdCharset_Map(const LcdRom_t Rom,
+                              const uint32_t CodePoint,
+                              uint8_t* const Codes);
+extern uint8_t LcdCharset_AddGlyph(const uint32_t CodePoint,
+                                   const uint8_t* const Bitmap);
+extern const uint8_t* LcdCharset_FindGlyph(const uint32_t CodePoint);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end LCD_CHARSET */
+/*****************************End of File ************************************/
@@ -19,6 +19,12 @@
  */
 #define LCD_DISPLAY_CMD_ID 0x80
 
+/**
+ * Data Identifier. A character with the most significant bit set (a ROM code
+ * from 0x80) is enqueued after it so that it's not taken for an identifier.
+ */
+#define LCD_DISPLAY_DATA_ID 0x81
+
 /**
  * DDRAM Identifier. This is a mask used to set DDRAM address.
  */
@@ -62,6 +68,38 @@
 
 #define LCD_DISPLAY_DDRAM_LINE_0 0x00 /**< DDRAM Address for line 0 */
 #define LCD_DISPLAY_DDRAM_LINE_1 0x40 /**< DDRAM Address for line 1 */
+#define LCD_DISPLAY_DDRAM_LINE_LEN 0x28 /**< DDRAM length of a line */
+#define LCD_DISPLAY_DDRAM_SIZE 80 /**< DDRAM size in bytes (2 lines) */
+#define LCD_DISPLAY_CGRAM_SIZE LCD_DISPLAY_CGRAM_BYTES /**< CGRAM size */
+#define LCD_DISPLAY_BUSY_FLAG 0x80 /**< the busy flag of a status read */
+#define LCD_DISPLAY_CGRAM_CHARS 8 /**< the CGRAM characters */
+
+#define LCD_DISPLAY_BLANK ' ' /**< the character of an empty cell */
+#define LCD_DISPLAY_MISSING '?' /**< the character of an unmapped code point */
+
+/**
+ * @brief the first CGRAM character used by LcdDisplay_SetUtf8 and the bytes
+ * that the upload of a glyph takes in the normal buffer of each controller
+ * (an address command and a row per glyph row then the cursor command)
+ */
+#define LCD_DISPLAY_GLYPH_FIRST (8 - LCD_DISPLAY_GLYPH_SLOTS)
+#define LCD_DISPLAY_GLYPH_BYTES (LCD_CHARSET_GLYPH_ROWS * 3 + 2)
+
+/**
+ * @brief a location (see LcdDisplay_GetLocation) holds the controller in its
+ * most significant bit and the DDRAM address in the rest of the bits.
+ */
+#define LCD_DISPLAY_LOC_CTRL LCD_GEOMETRY_CTRL2
+#define LCD_DISPLAY_LOC_ADDRESS 0x7F
+
+/**
+ * @brief a sequence number holds the lane in its 2 most significant bits 
+ * then the position in the lane of each controller in 31 bits.
+ */
+#define LCD_DISPLAY_SEQ_LANE_SHIFT 62
+#define LCD_DISPLAY_SEQ_POS_BITS 31
+#define LCD_DISPLAY_SEQ_POS_MASK 0x7FFFFFFFUL /**< the position bits */
+#define LCD_DISPLAY_SEQ_POS_HALF 0x40000000UL /**< half the position range */
 /******************************************************************************
  * Typedefs
  ******************************************************************************/
@@ -75,6 +113,97 @@ typedef enum
   LCD_DATA_FLAG_CMD,
   LCD_DATA_FLAG_MAX
 } LcdDataFlag_t;
+
+/**
+ * @brief enumeration for the lanes through which a display is written. Each 
+ * lane completes its writes in order.
+ */
+typedef enum
+{
+  LCD_LANE_NORMAL, /**< the normal buffer */
+  LCD_LANE_URGENT, /**< the high-priority buffer */
+  LCD_LANE_FRAME, /**< the committed frames */
+  LCD_LANE_MAX
+} LcdLane_t;
+
+/**
+ * @brief a pending completion callback
+ */
+typedef struct
+{
+  LcdDisplaySeq_t Seq; /**< the sequence number waited for */
+  LcdDisplayCallback_t Callback; /**< the callback, 0 if the entry is free */
+} LcdFence_t;
+
+#if LCD_DISPLAY_LATENCY == 1
+/**
+ * @brief a write waiting for its latency measurement
+ */
+typedef struct
+{
+  LcdDisplaySeq_t Seq; /**< the sequence number of the write */
+  uint32_t Tick; /**< the tick when it was enqueued */
+  uint8_t Used; /**< 1 if the entry is in use */
+} LcdStamp_t;
+#endif
+
+/**
+ * @brief the frame transaction state of a display
+ */
+typedef struct
+{
+  uint8_t Staging; /**< 1 between LcdDisplay_BeginFrame and EndFrame */
+  uint8_t Committed; /**< 1 once a frame is committed */
+  uint8_t Row; /**< the row of the frame cursor */
+  uint8_t Col; /**< the column of the frame cursor */
+} LcdFrame_t;
+
+/**
+ * @brief the state of a controller of a display. Most displays have one 
+ * HD44780 controller, 40x4 displays have two of them sharing the bus with
+ * an enable line each.
+ */
+typedef struct
+{
+  CircBuff_t Buff[LCD_LANE_FRAME]; /**< the normal and urgent buffers */
+  uint8_t Address; /**< the address counter shadow (see gCtrl) */
+  uint8_t SavedAddress; /**< the address counter of the normal buffer */
+  uint8_t Preempted; /**< 1 until the saved address counter is restored */
+  uint8_t Dirty; /**< 1 if the committed frame isn't fully on the display */
+  uint8_t Scan; /**< the next cell to compare against the display */
+  uint8_t Ddram[LCD_DISPLAY_DDRAM_SIZE]; /**< the DDRAM shadow */
+  uint8_t Cgram[LCD_DISPLAY_CGRAM_SIZE]; /**< the CGRAM shadow */
+  uint8_t Glyphs; /**< a bit per CGRAM character with an animation frame 
+                       to upload */
+  uint8_t Stale[LCD_DISPLAY_CGRAM_CHARS]; /**< a bit per CGRAM row that 
+                       isn't known to match its shadow */
+  uint32_t Enqueued[LCD_LANE_MAX]; /**< the bytes/frames written to a lane */
+  uint32_t Latched[LCD_LANE_MAX]; /**< the bytes/frames that reached it */
+} LcdCtrl_t;
+
+/**
+ * @brief the animation of a CGRAM character (see LcdDisplay_Animate)
+ */
+typedef struct
+{
+  const uint8_t* Frames; /**< the bitmaps, 0 if it's not animated */
+  uint8_t Count; /**< the number of frames */
+  uint8_t Frame; /**< the frame shown */
+  uint16_t Period; /**< the updates per frame */
+  uint16_t Ticks; /**< the updates left until the next frame */
+} LcdAnim_t;
+
+/**
+ * @brief the DDRAM scrub state of a display (see LcdDisplay_Scrub)
+ */
+typedef struct
+{
+  uint8_t Cell; /**< the next cell to read back */
+  uint8_t Repair; /**< 1 if the cell differs from the DDRAM shadow */
+  uint8_t Readable; /**< 1 if the controller accepts a read (after a set 
+                         DDRAM address or another read) */
+  uint8_t Stall; /**< the updates the busy flag stayed set */
+} LcdScrub_t;
 /******************************************************************************
  * Module variable definitions
  ******************************************************************************/
@@ -83,24 +212,244 @@ typedef enum
  */
 static const LcdDisplayConfig_t* gConfig;
 /**
- * @brief the Lcd displays data and commands buffers.
- * The most significant bit determines if the byte is a command or data. 
- * If it's 1, then the byte is a command.
+ * @brief the Lcd displays data and commands buffers of each controller.
+ * A command is preceded by LCD_DISPLAY_CMD_ID and a character from 0x80 by 
+ * LCD_DISPLAY_DATA_ID. The other bytes are characters.
+ */
+static uint8_t gData[LCD_DISPLAY_MAX][LCD_DISPLAY_CTRL_MAX]
+ [LCD_DISPLAY_BUFF_SIZE];
+
+/**
+ * @brief the Lcd displays high-priority (urgent) buffers of each controller.
+ * They have the same format as gData and they're serviced first by 
+ * LcdDisplay_Update.
+ */
+static uint8_t gUrgentData[LCD_DISPLAY_MAX][LCD_DISPLAY_CTRL_MAX]
+ [LCD_DISPLAY_URGENT_BUFF_SIZE];
+
+/**
+ * @brief the state of the controllers of each display. The address counter
+ * shadow is stored as the "set DDRAM/CGRAM address" command that brings the
+ * counter back. It's saved when the urgent lane or the frame preempts the 
+ * normal buffer and restored before the normal buffer is resumed.
+ */
+static LcdCtrl_t gCtrl[LCD_DISPLAY_MAX][LCD_DISPLAY_CTRL_MAX];
+
+/**
+ * @brief the number of controllers of each display
+ */
+static uint8_t gCtrlCount[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the controller of each display written by LcdDisplay_SetData. It's
+ * selected by LcdDisplay_SetCursor.
+ */
+static uint8_t gCtrlSel[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the location of each cell of each display, row by row. It's built
+ * by LcdDisplay_Init from the geometry of the display so that the location
+ * of a cell is a single table load.
+ */
+static uint8_t gLocation[LCD_DISPLAY_MAX][LCD_DISPLAY_MAX_CELLS];
+
+/**
+ * @brief the first cell of each row of each display
+ */
+static uint8_t gRowStart[LCD_DISPLAY_MAX][LCD_GEOMETRY_RUN_MAX];
+
+/**
+ * @brief the characters per contiguous DDRAM run of each display
+ */
+static uint8_t gRun[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the row and column of the buffered writes of each display. They're
+ * set by LcdDisplay_SetCursor and moved by LcdDisplay_SetData (the column 
+ * stops at the width) so that a row made of several runs continues at the
+ * start of the next run.
+ */
+static uint8_t gCursorRow[LCD_DISPLAY_MAX];
+static uint8_t gCursorCol[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the code point uploaded into each CGRAM character used by 
+ * LcdDisplay_SetUtf8 (from LCD_DISPLAY_GLYPH_FIRST) of each display, 0 if
+ * the character is free
+ */
+static uint32_t gGlyphCode[LCD_DISPLAY_MAX][LCD_DISPLAY_GLYPH_SLOTS];
+
+/**
+ * @brief the staging frame of each display (row-major). Writes between 
+ * LcdDisplay_BeginFrame and LcdDisplay_EndFrame land here.
+ */
+static uint8_t gBackFrame[LCD_DISPLAY_MAX][LCD_DISPLAY_MAX_CELLS];
+
+/**
+ * @brief the last committed frame of each display (row-major).
+ */
+static uint8_t gFrontFrame[LCD_DISPLAY_MAX][LCD_DISPLAY_MAX_CELLS];
+
+/**
+ * @brief the frame transaction state of each display
+ */
+static LcdFrame_t gFrame[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the number of times the content of each display changed (see 
+ * LcdDisplay_GetChanges)
+ */
+static uint32_t gChanges[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the sequence number of the last write to each display
+ */
+static LcdDisplaySeq_t gLastSeq[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the pending completion callbacks of each display
+ */
+static LcdFence_t gFences[LCD_DISPLAY_MAX][LCD_DISPLAY_FENCE_MAX];
+
+/**
+ * @brief the number of pending completion callbacks of each display
+ */
+static uint8_t gFenceCount[LCD_DISPLAY_MAX];
+
+#if LCD_DISPLAY_LATENCY == 1
+/**
+ * @brief the tick source of the latency measurement, 0 to stop it
+ */
+static LcdDisplayTicks_t gTicks;
+
+/**
+ * @brief the writes of each display waiting for their latency measurement
  */
-static uint8_t gData[LCD_DISPLAY_MAX][LCD_DISPLAY_BUFF_SIZE];
+static LcdStamp_t gStamps[LCD_DISPLAY_MAX][LCD_DISPLAY_LATENCY_STAMPS];
 
 /**
- * @brief the lcd displays data and commands buffers structures
+ * @brief the number of writes of each display waiting for their latency 
+ * measurement
  */
-static CircBuff_t gBuff[LCD_DISPLAY_MAX];
+static uint8_t gStampCount[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the latency histogram of each display
+ */
+static LcdDisplayLatency_t gLatency[LCD_DISPLAY_MAX];
+#endif
+
+/**
+ * @brief 1 if any display may have pending work, 0 if all of them are idle.
+ * It's set by the write paths and cleared by LcdDisplay_Update.
+ */
+static volatile uint8_t gAnyWork;
+
+/**
+ * @brief the animations of the CGRAM characters of each display
+ */
+static LcdAnim_t gAnim[LCD_DISPLAY_MAX][LCD_DISPLAY_CGRAM_CHARS];
+
+/**
+ * @brief the number of animated characters of each display and of all of 
+ * them. LcdDisplay_Update keeps running while any character is animated.
+ */
+static uint8_t gAnimCount[LCD_DISPLAY_MAX];
+static uint8_t gAnimations;
+
+/**
+ * @brief the DDRAM scrub state of each display
+ */
+static LcdScrub_t gScrub[LCD_DISPLAY_MAX];
+
+/**
+ * @brief 1 if any display is scrubbed. LcdDisplay_Update then runs even 
+ * when no write is pending.
+ */
+static uint8_t gScrubbing;
+
+/**
+ * @brief the commands that initialize a controller. Their order matters. 
+ * The return home first brings a controller that lost the 4-bit mode back 
+ * to it. The clear comes last so that a re-initialization can leave it out.
+ */
+static const uint8_t gInitCmds[] =
+{
+  LCD_DISPLAY_CMD_ADDRESS_RESET,
+  LCD_DISPLAY_CMD_4BIT,
+  LCD_DISPLAY_CMD_ON,
+  LCD_DISPLAY_CMD_INC,
+  LCD_DISPLAY_CMD_CLEAR
+};
+
+/**
+ * @brief 1 if the last latched byte is a command that takes the controller
+ * a long time (clear/return home), 0 otherwise. No other byte is sent to 
+ * the display in the same update after it.
+ */
+static uint8_t gLongCommand;
 
 /******************************************************************************
  * Functions Prototypes
  ******************************************************************************/
-static void LcdDisplay_SendByte(LcdDisplay_t Display, uint8_t Data,
+static void LcdDisplay_SendByte(LcdDisplay_t Display, uint8_t Ctrl,
+ uint8_t Data, LcdDataFlag_t Flag);
+static const LcdTransport_t* LcdDisplay_GetTransport(LcdDisplay_t Display);
+static uint8_t LcdDisplay_SetCommand(LcdDisplay_t Display, uint8_t Command,
+ LcdDisplaySeq_t* const Seq);
+static uint8_t LcdDisplay_PushCommand(LcdDisplay_t Display, uint8_t Ctrl,
+ LcdLane_t Lane, uint8_t Command);
+static uint8_t LcdDisplay_PushData(LcdDisplay_t Display, uint8_t Ctrl,
+ LcdLane_t Lane, const uint8_t* const Data, const uint8_t DataSize);
+static uint8_t LcdDisplay_PushAll(LcdDisplay_t Display, uint8_t Command);
+static uint8_t LcdDisplay_PushText(LcdDisplay_t Display, uint8_t Ctrl,
+ LcdLane_t Lane, uint8_t Row, uint8_t Col, const uint8_t* const Data,
+ const uint8_t DataSize);
+static uint8_t LcdDisplay_CountRuns(LcdDisplay_t Display, uint8_t Col,
+ uint8_t DataSize);
+static void LcdDisplay_Advance(LcdDisplay_t Display, uint8_t Ctrl,
+ LcdLane_t Lane, uint16_t Count);
+static void LcdDisplay_Ticket(LcdDisplay_t Display, LcdLane_t Lane,
+ LcdDisplaySeq_t* const Seq);
+static void LcdDisplay_Notify(LcdDisplay_t Display);
+#if LCD_DISPLAY_LATENCY == 1
+static void LcdDisplay_Stamp(LcdDisplay_t Display);
+static void LcdDisplay_Measure(LcdDisplay_t Display);
+#endif
+static uint8_t LcdDisplay_SendNext(LcdDisplay_t Display, uint8_t Ctrl,
+ LcdLane_t Lane);
+static uint8_t LcdDisplay_Service(LcdDisplay_t Display, uint8_t Ctrl);
+static uint8_t LcdDisplay_IsBusy(LcdDisplay_t Display);
+static void LcdDisplay_Latch(LcdDisplay_t Display, uint8_t Ctrl, uint8_t Data,
+ LcdDataFlag_t Flag);
+static void LcdDisplay_Track(LcdDisplay_t Display, uint8_t Ctrl, uint8_t Data,
  LcdDataFlag_t Flag);
-static void LcdDisplay_Delay(void);
-static void LcdDisplay_SetCommand(LcdDisplay_t Display, uint8_t Command);
+static uint8_t LcdDisplay_DdramIndex(uint8_t Address);
+static uint8_t LcdDisplay_NextAddress(uint8_t Address);
+static uint8_t LcdDisplay_CanScrub(LcdDisplay_t Display);
+static void LcdDisplay_Scrub(LcdDisplay_t Display);
+static void LcdDisplay_Reinit(LcdDisplay_t Display, uint8_t Ctrl);
+static void LcdDisplay_StepAnimations(LcdDisplay_t Display);
+static uint8_t LcdDisplay_SendGlyph(LcdDisplay_t Display, uint8_t Ctrl);
+static void LcdDisplay_FrameLoad(LcdDisplay_t Display, uint8_t* const Frame);
+static void LcdDisplay_FrameFill(uint8_t* const Frame, uint8_t Size,
+ uint8_t Data);
+static uint8_t LcdDisplay_FrameStore(LcdDisplay_t Display, uint8_t* const Frame,
+ uint8_t Row, uint8_t Col, const uint8_t* const Data, uint8_t DataSize);
+static uint8_t LcdDisplay_FrameWrite(LcdDisplay_t Display,
+ const uint8_t* const Data, uint8_t DataSize);
+static void LcdDisplay_FrameDirty(LcdDisplay_t Display);
+static uint8_t LcdDisplay_SendFrame(LcdDisplay_t Display, uint8_t Ctrl);
+static uint8_t LcdDisplay_GetLocation(LcdDisplay_t Display, uint8_t Row,
+ uint8_t Col);
+static uint8_t LcdDisplay_BuildLayout(LcdDisplay_t Display);
+static uint8_t LcdDisplay_GetCursorCommand(LcdDisplay_t Display);
+static uint8_t LcdDisplay_CountEscapes(const uint8_t* const Data,
+ uint8_t DataSize);
+static uint8_t LcdDisplay_GetGlyph(LcdDisplay_t Display, uint32_t CodePoint);
+static uint8_t LcdDisplay_WriteCodes(LcdDisplay_t Display,
+ const uint8_t* const Codes, const uint8_t* const Ends, uint8_t* const Count,
+ uint8_t* const Used, LcdDisplaySeq_t* const Seq);
 /******************************************************************************
  * Functions definitions
  ******************************************************************************/
@@ -121,36 +470,117 @@ LcdDisplay_Init(const LcdDisplayConfig_t * const Config)
       return;
     }
 
-  //The commands that're required for LCD display initialization. 
-  //Orders of the commands matter
-  const uint8_t InitCmds[] =
-  {
-    LCD_DISPLAY_CMD_ADDRESS_RESET,
-    LCD_DISPLAY_CMD_4BIT,
-    LCD_DISPLAY_CMD_ON,
-    LCD_DISPLAY_CMD_INC,
-    LCD_DISPLAY_CMD_CLEAR
-  };
-
   LcdDisplay_t Display;
+  LcdLane_t Lane;
+  LcdCtrl_t* Ctrl;
+  uint8_t CtrlId;
   uint8_t cmd;
+  uint8_t Fence;
+  uint8_t Slot;
+
+  const LcdTransport_t* Transport;
 
   //assign the internal config pointer
   gConfig = Config;
+  gScrubbing = 0;
+  gAnimations = 0;
 
   //initialize the buffers
   for(Display = 0; Display < LCD_DISPLAY_MAX; Display++)
     {
-      gBuff[Display] = CircBuff_Create(gData[Display],
-       LCD_DISPLAY_BUFF_SIZE);
+      gCtrlCount[Display] = LcdDisplay_BuildLayout(Display);
+      if(!(gCtrlCount[Display] <= LCD_DISPLAY_CTRL_MAX))
+        {
+          //TODO: handle this error
+          gCtrlCount[Display] = 0;
+        }
+      gCtrlSel[Display] = 0;
+      gCursorRow[Display] = 0;
+      gCursorCol[Display] = 0;
+
+      for(Slot = 0; Slot < LCD_DISPLAY_GLYPH_SLOTS; Slot++)
+        {
+          gGlyphCode[Display][Slot] = 0;
+        }
+
+      for(Slot = 0; Slot < LCD_DISPLAY_CGRAM_CHARS; Slot++)
+        {
+          gAnim[Display][Slot].Frames = 0x00;
+        }
+      gAnimCount[Display] = 0;
+
+      for(CtrlId = 0; CtrlId < LCD_DISPLAY_CTRL_MAX; CtrlId++)
+        {
+          Ctrl = &gCtrl[Display][CtrlId];
+          Ctrl->Buff[LCD_LANE_NORMAL] = CircBuff_Create(
+           gData[Display][CtrlId], LCD_DISPLAY_BUFF_SIZE);
+          Ctrl->Buff[LCD_LANE_URGENT] = CircBuff_Create(
+           gUrgentData[Display][CtrlId], LCD_DISPLAY_URGENT_BUFF_SIZE);
+          Ctrl->Address = LCD_DISPLAY_DDRAM_MASK | LCD_DISPLAY_DDRAM_LINE_0;
+          Ctrl->Preempted = 0;
+          Ctrl->Dirty = 0;
+          Ctrl->Scan = 0;
+          Ctrl->Glyphs = 0;
+          LcdDisplay_FrameFill(Ctrl->Ddram, LCD_DISPLAY_DDRAM_SIZE,
+           LCD_DISPLAY_BLANK);
+          LcdDisplay_FrameFill(Ctrl->Cgram, LCD_DISPLAY_CGRAM_SIZE, 0);
+          LcdDisplay_FrameFill(Ctrl->Stale, LCD_DISPLAY_CGRAM_CHARS, 0);
+
+          for(Lane = LCD_LANE_NORMAL; Lane < LCD_LANE_MAX; Lane++)
+            {
+              Ctrl->Enqueued[Lane] = 0;
+              Ctrl->Latched[Lane] = 0;
+            }
+        }
+
+      LcdDisplay_FrameFill(gFrontFrame[Display], LCD_DISPLAY_MAX_CELLS,
+       LCD_DISPLAY_BLANK);
+      gFrame[Display].Staging = 0;
+      gFrame[Display].Committed = 0;
+      gFrame[Display].Row = 0;
+      gFrame[Display].Col = 0;
+      gLastSeq[Display] = 0;
+      gChanges[Display] = 0;
+
+      for(Fence = 0; Fence < LCD_DISPLAY_FENCE_MAX; Fence++)
+        {
+          gFences[Display][Fence].Callback = 0x00;
+        }
+      gFenceCount[Display] = 0;
+
+#if LCD_DISPLAY_LATENCY == 1
+      for(Fence = 0; Fence < LCD_DISPLAY_LATENCY_STAMPS; Fence++)
+        {
+          gStamps[Display][Fence].Used = 0;
+        }
+      gStampCount[Display] = 0;
+      LcdDisplay_ResetLatency(Display);
+#endif
+
+      gScrub[Display].Cell = 0;
+      gScrub[Display].Repair = 0;
+      gScrub[Display].Readable = 0;
+      gScrub[Display].Stall = 0;
+      gScrubbing |= LcdDisplay_CanScrub(Display);
+
+      Transport = LcdDisplay_GetTransport(Display);
+      if(Transport->Init != 0x00)
+        {
+          Transport->Init(&gConfig[Display]);
+        }
     }
   
-  //add init commands
+  //add init commands. They go through the urgent lane so that an urgent
+  //message posted right after the initialization isn't cleared by them
   for(Display = 0; Display < LCD_DISPLAY_MAX; Display++)
     {
-      for(cmd = 0; cmd < sizeof(InitCmds); cmd++)
+      for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
         {
-          LcdDisplay_SetCommand(Display, InitCmds[cmd]);
+          for(cmd = 0; cmd < sizeof(gInitCmds); cmd++)
+            {
+              (void)LcdDisplay_PushCommand(Display, CtrlId, LCD_LANE_URGENT,
+               gInitCmds[cmd]);
+            }
         }
     }
 }
@@ -158,226 +588,2432 @@ LcdDisplay_Init(const LcdDisplayConfig_t * const Config)
 /******************************************************************************
 * Function : LcdDisplay_Clear()
 *//**
-* \b Description: Clear the Display and move the cursor to the first char<br/>
+* \b Description: Clear the Display and move the cursor to the first char.
+* Inside a frame or once a frame is committed, the frame is cleared instead<br/>
 * \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
 * @param Display The id of the display.
-* @return void 
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
+* @return uint8_t 1 if the clear is set, 0 otherwise (the buffer is full)
 ******************************************************************************/
-extern void 
-LcdDisplay_Clear(LcdDisplay_t Display)
+extern uint8_t 
+LcdDisplay_Clear(LcdDisplay_t Display, LcdDisplaySeq_t* const Seq)
 {
   if(!(Display < LCD_DISPLAY_MAX))
     {
       //TODO: handle this error
-      return;
+      return 0;
+    }
+
+  LcdFrame_t* Frame = &gFrame[Display];
+  LcdLane_t Lane = LCD_LANE_FRAME;
+  uint8_t res = 1;
+
+  if(Frame->Staging == 1)
+    {
+      LcdDisplay_FrameFill(gBackFrame[Display], LCD_DISPLAY_MAX_CELLS,
+       LCD_DISPLAY_BLANK);
+      Frame->Row = 0;
+      Frame->Col = 0;
+    }
+  else if(Frame->Committed == 1)
+    {
+      LcdDisplay_FrameFill(gFrontFrame[Display], LCD_DISPLAY_MAX_CELLS,
+       LCD_DISPLAY_BLANK);
+      Frame->Row = 0;
+      Frame->Col = 0;
+      LcdDisplay_FrameDirty(Display);
+    }
+  else
+    {
+      //both controllers of a 40x4 display are cleared
+      gCtrlSel[Display] = 0;
+      gCursorRow[Display] = 0;
+      gCursorCol[Display] = 0;
+      Lane = LCD_LANE_NORMAL;
+      res = LcdDisplay_PushAll(Display, LCD_DISPLAY_CMD_CLEAR);
+    }
+
+  if(res == 0)
+    {
+      return 0;
+    }
+
+  LcdDisplay_Ticket(Display, Lane, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  //a staged clear is measured from LcdDisplay_EndFrame
+  if(Frame->Staging == 0)
+    {
+      LcdDisplay_Stamp(Display);
     }
+#endif
 
-  LcdDisplay_SetCommand(Display, LCD_DISPLAY_CMD_CLEAR);
+  return res;
 }
 
 /******************************************************************************
-* Function : LcdDisplay_SetCommand()
+* Function : LcdDisplay_BeginFrame()
 *//**
-* \b Description: A function to set a command in the LCD buffer. It set an 
-* identifier to (identify that it's a command) then the command.<br/>
+* \b Description: Start a frame transaction. Until LcdDisplay_EndFrame is 
+* called, LcdDisplay_SetData, LcdDisplay_SetCursor and LcdDisplay_Clear 
+* write into a staging frame that starts as a copy of the committed one 
+* (or of the display content for the first frame). 
+* Nothing reaches the display before the frame is committed, and the 
+* sequence numbers of the staged writes are complete with that frame.<br/>
+* Once a frame is committed, the display mirrors the committed frame and 
+* writes outside a transaction are applied to it directly, until 
+* LcdDisplay_EndFrames goes back to the buffered writes.<br/>
 * \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
 * @param Display The id of the display.
-* @param Command The command.
 * @return void 
+*
+* \b Example:
+* @code
+* LcdDisplay_BeginFrame(LCD_DISPLAY_0);
+* LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+* LcdDisplay_SetData(LCD_DISPLAY_0, Value, 4, 0x00);
+* LcdDisplay_SetData(LCD_DISPLAY_0, Unit, 2, 0x00);
+* LcdDisplay_EndFrame(LCD_DISPLAY_0, 0x00); //value and unit show up together
+* @endcode
+*
+* @see LcdDisplay_EndFrame
+* @see LcdDisplay_EndFrames
 ******************************************************************************/
-static void 
-LcdDisplay_SetCommand(LcdDisplay_t Display, uint8_t Command)
+extern void
+LcdDisplay_BeginFrame(const LcdDisplay_t Display)
 {
- if(!(Display < LCD_DISPLAY_MAX))
+  if(!(Display < LCD_DISPLAY_MAX))
     {
       //TODO: handle this error
       return;
     }
-  
-  uint8_t res;
 
-  res = CircBuff_Enqueue(&gBuff[Display], LCD_DISPLAY_CMD_ID);
-  if(res == 0) 
+  const uint8_t Cells = gConfig[Display].Width * gConfig[Display].Height;
+  uint8_t Cell;
+
+  if(gFrame[Display].Committed == 1)
     {
-      //TODO handle this error
-      return;
+      for(Cell = 0; Cell < Cells; Cell++)
+        {
+          gBackFrame[Display][Cell] = gFrontFrame[Display][Cell];
+        }
     }
-
-  res = CircBuff_Enqueue(&gBuff[Display], Command);
-  if(res == 0)
+  else
     {
-      //TODO handle this error
-      return;
+      //the first frame starts from what the buffered writes showed
+      LcdDisplay_FrameLoad(Display, gBackFrame[Display]);
     }
-}
 
+  gFrame[Display].Staging = 1;
+}
 
 /******************************************************************************
-* Function : LcdDisplay_Delay()
+* Function : LcdDisplay_EndFrame()
 *//**
-* \b Description: Utility function used to make a small software delay for 
-* the enable pin cycle of the LCD Display <br/>
+* \b Description: Commit the staging frame. LcdDisplay_Update then sends 
+* only the cells that differ from the display. If a frame is committed 
+* before the previous one is flushed, the display goes straight to the 
+* latest frame without showing the stale one.<br/>
+* \b PRE-CONDITION: LcdDisplay_BeginFrame is called <br/>
+* @param Display The id of the display.
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
 * @return void 
+*
+* @see LcdDisplay_BeginFrame
 ******************************************************************************/
-static void 
-LcdDisplay_Delay(void)
+extern void
+LcdDisplay_EndFrame(const LcdDisplay_t Display, LcdDisplaySeq_t* const Seq)
 {
-  //dummy delay
-  uint8_t x = 0;
-  x++;
-  x++;
-  x++;
+  if(!(Display < LCD_DISPLAY_MAX && gFrame[Display].Staging == 1))
+    {
+      //TODO: handle this error
+      return;
+    }
+
+  uint8_t Cell;
+
+  for(Cell = 0; Cell < LCD_DISPLAY_MAX_CELLS; Cell++)
+    {
+      gFrontFrame[Display][Cell] = gBackFrame[Display][Cell];
+    }
+
+  gFrame[Display].Staging = 0;
+  gFrame[Display].Committed = 1;
+  LcdDisplay_FrameDirty(Display);
+  LcdDisplay_Ticket(Display, LCD_LANE_FRAME, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  LcdDisplay_Stamp(Display);
+#endif
 }
 
 /******************************************************************************
-* Function : LcdDisplay_SetData()
+* Function : LcdDisplay_EndFrames()
 *//**
-* \b Description: Set data in Lcd buffer to show it<br/>
+* \b Description: Leave the frames: the writes go back to the buffers as 
+* before the first LcdDisplay_BeginFrame and continue at the frame cursor.
+* The display keeps the last committed frame. It's refused until that frame
+* is fully on the display (see the Seq of LcdDisplay_EndFrame), otherwise 
+* its flushing would overwrite the buffered writes.<br/>
 * \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
 * @param Display The id of the display.
-* @param Data A pointer to the data to show.
-* @param DataSize The number of characters to send
-* @return uint8_t how many characters are sent
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
+* @return uint8_t 1 if the display is out of the frames, 0 otherwise (inside
+* a frame, the committed frame is still flushing or the buffer is full)
+*
+* \b Example:
+* @code
+* LcdDisplay_EndFrame(LCD_DISPLAY_0, &FrameSeq);
+* ...
+* if(LcdDisplay_IsComplete(LCD_DISPLAY_0, FrameSeq) == 1)
+*   {
+*     (void)LcdDisplay_EndFrames(LCD_DISPLAY_0, 0x00);
+*   }
+* @endcode
+*
+* @see LcdDisplay_BeginFrame
 ******************************************************************************/
-extern uint8_t 
-LcdDisplay_SetData(const LcdDisplay_t Display,
-                   const uint8_t* const Data,
-                   const uint8_t DataSize)
+extern uint8_t
+LcdDisplay_EndFrames(const LcdDisplay_t Display, LcdDisplaySeq_t* const Seq)
 {
-  if(!(Data != 0x00 && Display < LCD_DISPLAY_MAX))
-  {
-    //TODO: Handle this error
-    return 0;
-  }
+  if(!(Display < LCD_DISPLAY_MAX && gFrame[Display].Staging == 0))
+    {
+      //TODO: handle this error
+      return 0;
+    }
 
-  if(DataSize == 0) return 0;
+  const uint8_t Width = gConfig[Display].Width;
+  uint8_t Location;
+  uint8_t CtrlId;
 
-  uint8_t res;
-  uint8_t i = 0;
-  uint8_t ModifiedData;
+  if(gFrame[Display].Committed == 0) return 1;
 
-  do{
-    //Make the most significant bit 0 to mark as a data not a command
-    ModifiedData = Data[i] & (~LCD_DISPLAY_CMD_ID);
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      if(gCtrl[Display][CtrlId].Dirty == 1) return 0;
+    }
 
-    res = CircBuff_Enqueue(&gBuff[Display], ModifiedData);
+  Location = LcdDisplay_GetLocation(Display, gFrame[Display].Row,
+   (gFrame[Display].Col < Width) ? gFrame[Display].Col : Width - 1);
+  gCtrlSel[Display] = (Location & LCD_DISPLAY_LOC_CTRL) != 0;
+  gCursorRow[Display] = gFrame[Display].Row;
+  gCursorCol[Display] = gFrame[Display].Col;
 
-    if(res == 1)
-      {
-        i++;
-      }
-  } while(res == 1 && i < DataSize);
+  //the frame flushing left the address counter anywhere
+  if(LcdDisplay_PushCommand(Display, gCtrlSel[Display], LCD_LANE_NORMAL,
+      LcdDisplay_GetCursorCommand(Display)) == 0)
+    {
+      return 0;
+    }
 
-  return i;
+  gFrame[Display].Committed = 0;
+  LcdDisplay_Ticket(Display, LCD_LANE_NORMAL, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  LcdDisplay_Stamp(Display);
+#endif
+
+  return 1;
 }
 
 /******************************************************************************
-* Function : LcdDisplay_Update()
+* Function : LcdDisplay_FrameDirty()
 *//**
-* \b Description: When this function is called, it send a new byte 
-* representing a command or a data. It takes care of RS and EN pins <br/>
-* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
-* \b POST-CONDITION: The new data/command is sent to LCDs <br/>
-* @return void
+* \b Description: Utility function to mark the committed frame as not on the
+* display. Every controller rescans its cells from the start.<br/>
+* @param Display The id of the display.
+* @return void 
 ******************************************************************************/
-extern void 
-LcdDisplay_Update(void)
+static void
+LcdDisplay_FrameDirty(LcdDisplay_t Display)
 {
-  LcdDisplay_t Display;
-  uint8_t Data;
-  uint8_t res;
+  uint8_t CtrlId;
 
-  for(Display = LCD_DISPLAY_0; Display < LCD_DISPLAY_MAX; Display++)
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
     {
-      // Find the next data/command
-      res = CircBuff_Dequeue(&gBuff[Display], &Data);
-      if(res == 0) continue;
+      gCtrl[Display][CtrlId].Dirty = 1;
+      gCtrl[Display][CtrlId].Scan = 0;
+    }
 
-      //Is it data or command
-      if(Data == LCD_DISPLAY_CMD_ID)
-        {
-          res = CircBuff_Dequeue(&gBuff[Display], &Data);
-          if(res == 0)
-            {
-              //TODO: handle this error.
-              return;
-            }
+  //the frames are counted by the first controller
+  LcdDisplay_Advance(Display, 0, LCD_LANE_FRAME, 1);
+}
 
-          LcdDisplay_SendByte(Display, Data, LCD_DATA_FLAG_CMD);
-        }
+/******************************************************************************
+* Function : LcdDisplay_FrameLoad()
+*//**
+* \b Description: Utility function to load a frame buffer with the display 
+* content from the DDRAM shadows<br/>
+* @param Display The id of the display.
+* @param Frame a valid pointer to the frame buffer.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_FrameLoad(LcdDisplay_t Display, uint8_t* const Frame)
+{
+  const uint8_t Cells = gConfig[Display].Width * gConfig[Display].Height;
+  uint8_t Cell;
+  uint8_t Location;
+
+  for(Cell = 0; Cell < Cells; Cell++)
+    {
+      Location = gLocation[Display][Cell];
+      Frame[Cell] = gCtrl[Display][(Location & LCD_DISPLAY_LOC_CTRL) != 0]
+       .Ddram[LcdDisplay_DdramIndex(Location)];
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplay_FrameFill()
+*//**
+* \b Description: Utility function to fill a frame buffer with a byte<br/>
+* @param Frame a valid pointer to the frame buffer.
+* @param Size The size of the frame buffer.
+* @param Data The byte to fill with.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_FrameFill(uint8_t* const Frame, uint8_t Size, uint8_t Data)
+{
+  uint8_t Cell;
+
+  for(Cell = 0; Cell < Size; Cell++)
+    {
+      Frame[Cell] = Data;
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplay_FrameStore()
+*//**
+* \b Description: Utility function to store characters in a frame buffer at
+* a position. The characters are clipped at the end of the row.<br/>
+* \b PRE-CONDITION: Row and Col are inside the display <br/>
+* @param Display The id of the display.
+* @param Frame a valid pointer to the frame buffer.
+* @param Row The row of the first character.
+* @param Col The column of the first character.
+* @param Data A pointer to the characters.
+* @param DataSize The number of characters.
+* @return uint8_t how many characters are stored
+******************************************************************************/
+static uint8_t
+LcdDisplay_FrameStore(LcdDisplay_t Display, uint8_t* const Frame,
+ uint8_t Row, uint8_t Col, const uint8_t* const Data, uint8_t DataSize)
+{
+  const uint8_t Width = gConfig[Display].Width;
+  uint8_t* Cell = &Frame[gRowStart[Display][Row]];
+  uint8_t i = 0;
+
+  while(i < DataSize && Col < Width)
+    {
+      Cell[Col] = Data[i];
+      Col++;
+      i++;
+    }
+
+  return i;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_FrameWrite()
+*//**
+* \b Description: Utility function to write characters at the frame cursor,
+* into the staging frame inside a transaction or into the committed frame 
+* otherwise<br/>
+* @param Display The id of the display.
+* @param Data A pointer to the characters.
+* @param DataSize The number of characters.
+* @return uint8_t how many characters are written
+******************************************************************************/
+static uint8_t
+LcdDisplay_FrameWrite(LcdDisplay_t Display, const uint8_t* const Data,
+ uint8_t DataSize)
+{
+  LcdFrame_t* Frame = &gFrame[Display];
+  uint8_t Written;
+
+  if(Frame->Staging == 1)
+    {
+      Written = LcdDisplay_FrameStore(Display, gBackFrame[Display],
+       Frame->Row, Frame->Col, Data, DataSize);
+    }
+  else
+    {
+      Written = LcdDisplay_FrameStore(Display, gFrontFrame[Display],
+       Frame->Row, Frame->Col, Data, DataSize);
+
+      //nothing to flush past the end of the row
+      if(Written != 0)
+        {
+          LcdDisplay_FrameDirty(Display);
+        }
+    }
+
+  Frame->Col += Written;
+
+  return Written;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SetCommand()
+*//**
+* \b Description: A function to set a command in the LCD buffer of the 
+* selected controller. It set an identifier to (identify that it's a command)
+* then the command.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Command The command.
+* @param Seq A pointer to store the sequence number of the command, 0x00 if
+* it isn't needed.
+* @return uint8_t 1 if the command is set, 0 otherwise
+******************************************************************************/
+static uint8_t 
+LcdDisplay_SetCommand(LcdDisplay_t Display, uint8_t Command,
+ LcdDisplaySeq_t* const Seq)
+{
+ if(!(Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+  
+  uint8_t res;
+
+  res = LcdDisplay_PushCommand(Display, gCtrlSel[Display], LCD_LANE_NORMAL,
+   Command);
+  if(res == 0) 
+    {
+      //TODO handle this error
+      return 0;
+    }
+
+  LcdDisplay_Ticket(Display, LCD_LANE_NORMAL, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  LcdDisplay_Stamp(Display);
+#endif
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_PushAll()
+*//**
+* \b Description: Utility function to enqueue a command into the normal 
+* buffers of all the controllers of a display. It's enqueued into all of 
+* them or none of them.<br/>
+* @param Display The id of the display.
+* @param Command The command.
+* @return uint8_t 1 if the command is enqueued, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_PushAll(LcdDisplay_t Display, uint8_t Command)
+{
+  uint8_t CtrlId;
+
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      //the identifier and the command
+      if(CircBuff_GetFree(&gCtrl[Display][CtrlId].Buff[LCD_LANE_NORMAL]) < 2)
+        {
+          return 0;
+        }
+    }
+
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      (void)LcdDisplay_PushCommand(Display, CtrlId, LCD_LANE_NORMAL, Command);
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_PushCommand()
+*//**
+* \b Description: Utility function to enqueue a command with its identifier
+* into a lane. Both bytes are enqueued or none of them so that the buffer
+* never holds a dangling identifier.<br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Lane The lane (normal or urgent).
+* @param Command The command.
+* @return uint8_t 1 if the command is enqueued, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_PushCommand(LcdDisplay_t Display, uint8_t Ctrl, LcdLane_t Lane,
+ uint8_t Command)
+{
+  CircBuff_t* Buff = &gCtrl[Display][Ctrl].Buff[Lane];
+
+  if(CircBuff_GetFree(Buff) < 2)
+    {
+      return 0;
+    }
+
+  (void)CircBuff_Enqueue(Buff, LCD_DISPLAY_CMD_ID);
+  (void)CircBuff_Enqueue(Buff, Command);
+  LcdDisplay_Advance(Display, Ctrl, Lane, 2);
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_PushData()
+*//**
+* \b Description: Utility function to enqueue characters into a lane<br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Lane The lane (normal or urgent).
+* @param Data A pointer to the data to show.
+* @param DataSize The number of characters to send
+* @return uint8_t how many characters are enqueued
+******************************************************************************/
+static uint8_t
+LcdDisplay_PushData(LcdDisplay_t Display, uint8_t Ctrl, LcdLane_t Lane,
+ const uint8_t* const Data, const uint8_t DataSize)
+{
+  CircBuff_t* Buff = &gCtrl[Display][Ctrl].Buff[Lane];
+  uint8_t res;
+  uint8_t i = 0;
+  uint16_t Bytes = 0;
+
+  if(DataSize == 0) return 0;
+
+  do{
+    //A character with the most significant bit set is escaped. Both bytes
+    //are enqueued or none of them.
+    if(Data[i] & LCD_DISPLAY_CMD_ID)
+      {
+        res = (CircBuff_GetFree(Buff) >= 2);
+        if(res == 1)
+          {
+            (void)CircBuff_Enqueue(Buff, LCD_DISPLAY_DATA_ID);
+            (void)CircBuff_Enqueue(Buff, Data[i]);
+            Bytes += 2;
+          }
+      }
+    else
+      {
+        res = CircBuff_Enqueue(Buff, Data[i]);
+        Bytes += res;
+      }
+
+    if(res == 1)
+      {
+        i++;
+      }
+  } while(res == 1 && i < DataSize);
+
+  LcdDisplay_Advance(Display, Ctrl, Lane, Bytes);
+
+  return i;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_PushText()
+*//**
+* \b Description: Utility function to enqueue characters written at a 
+* position into a lane. When a row is made of several DDRAM runs (16x1), a
+* cursor command is enqueued at the start of each run.<br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Lane The lane (normal or urgent).
+* @param Row The row of the first character.
+* @param Col The column of the first character.
+* @param Data A pointer to the data to show.
+* @param DataSize The number of characters to send
+* @return uint8_t how many characters are enqueued
+******************************************************************************/
+static uint8_t
+LcdDisplay_PushText(LcdDisplay_t Display, uint8_t Ctrl, LcdLane_t Lane,
+ uint8_t Row, uint8_t Col, const uint8_t* const Data, const uint8_t DataSize)
+{
+  const uint8_t Width = gConfig[Display].Width;
+  const uint8_t Run = gRun[Display];
+  uint8_t Pushed = 0;
+  uint8_t Chunk;
+  uint8_t Done;
+  uint8_t Location;
+
+  while(Pushed < DataSize)
+    {
+      Chunk = DataSize - Pushed;
+
+      //stop at the end of the run unless it's the end of the row
+      if(Col < Width && Col / Run != (Width - 1) / Run &&
+         Chunk > Run - Col % Run)
+        {
+          Chunk = Run - Col % Run;
+        }
+
+      Done = LcdDisplay_PushData(Display, Ctrl, Lane, &Data[Pushed], Chunk);
+      Pushed += Done;
+      if(Done < Chunk || Pushed == DataSize) break;
+
+      Col += Done;
+      Location = LcdDisplay_GetLocation(Display, Row, Col);
+      if(LcdDisplay_PushCommand(Display, Ctrl, Lane,
+       (Location & LCD_DISPLAY_LOC_ADDRESS) | LCD_DISPLAY_DDRAM_MASK) == 0)
+        {
+          break;
+        }
+    }
+
+  return Pushed;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_CountRuns()
+*//**
+* \b Description: Utility function to count the DDRAM runs crossed by 
+* characters written at a column, i.e. the cursor commands that 
+* LcdDisplay_PushText enqueues plus the first one<br/>
+* @param Display The id of the display.
+* @param Col The column of the first character.
+* @param DataSize The number of characters.
+* @return uint8_t the number of runs
+******************************************************************************/
+static uint8_t
+LcdDisplay_CountRuns(LcdDisplay_t Display, uint8_t Col, uint8_t DataSize)
+{
+  const uint8_t Width = gConfig[Display].Width;
+  const uint8_t Run = gRun[Display];
+  uint16_t End = (uint16_t)Col + DataSize;
+
+  if(End > Width) End = Width;
+  if(End <= Col) return 1;
+
+  return (uint8_t)(1 + (End - 1) / Run - Col / Run);
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Advance()
+*//**
+* \b Description: Utility function to account for bytes/frames written into a
+* lane of a controller<br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Lane The lane.
+* @param Count The number of bytes/frames written.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Advance(LcdDisplay_t Display, uint8_t Ctrl, LcdLane_t Lane,
+ uint16_t Count)
+{
+  gCtrl[Display][Ctrl].Enqueued[Lane] += Count;
+  gAnyWork = 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Ticket()
+*//**
+* \b Description: Utility function to get the sequence number of everything
+* written into a lane of a display so far. It holds the position of the lane
+* of every controller. It becomes the sequence number of the last write 
+* (see LcdDisplay_GetSeq), so only the writes of the application call it, 
+* not the internal ones of the scrub or the animations. Inside a frame, it's
+* the position of the frame that LcdDisplay_EndFrame commits next, so a 
+* staged write isn't complete before that frame is on the display.<br/>
+* @param Display The id of the display.
+* @param Lane The lane.
+* @param Seq A pointer to store the sequence number, 0x00 if it isn't needed.
+* @return void
+******************************************************************************/
+static void
+LcdDisplay_Ticket(LcdDisplay_t Display, LcdLane_t Lane,
+ LcdDisplaySeq_t* const Seq)
+{
+  LcdDisplaySeq_t Ticket = (LcdDisplaySeq_t)Lane << LCD_DISPLAY_SEQ_LANE_SHIFT;
+  uint32_t Position;
+  uint8_t CtrlId;
+
+  for(CtrlId = 0; CtrlId < LCD_DISPLAY_CTRL_MAX; CtrlId++)
+    {
+      Position = gCtrl[Display][CtrlId].Enqueued[Lane];
+
+      //a staged write waits for the frame LcdDisplay_EndFrame commits next
+      //(the frames are counted by the first controller)
+      if(Lane == LCD_LANE_FRAME && CtrlId == 0 &&
+         gFrame[Display].Staging == 1)
+        {
+          Position++;
+        }
+
+      Ticket |= (LcdDisplaySeq_t)(Position & LCD_DISPLAY_SEQ_POS_MASK) <<
+       (LCD_DISPLAY_SEQ_POS_BITS * CtrlId);
+    }
+
+  gLastSeq[Display] = Ticket;
+
+  if(Seq != 0x00)
+    {
+      *Seq = Ticket;
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetSeq()
+*//**
+* \b Description: Get the sequence number of the last write to the display
+* (LcdDisplay_SetData, LcdDisplay_SetCursor, LcdDisplay_Clear, 
+* LcdDisplay_SetUrgent, LcdDisplay_CreateChar or LcdDisplay_EndFrame). It's
+* complete once that write and everything before it in the same lane reached
+* the display.<br/>
+* Another writer (e.g. the flusher of lcd_display_mt.h) can write between a
+* write and this call; the Seq parameter of the write gives its own sequence
+* number instead.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @return LcdDisplaySeq_t the sequence number, 0 if the display is invalid
+*
+* \b Example:
+* @code
+* LcdDisplay_SetData(LCD_DISPLAY_0, Menu, MenuSize, &MenuSeq);
+* ...
+* if(LcdDisplay_IsComplete(LCD_DISPLAY_0, MenuSeq)) ReadButtons();
+* @endcode
+*
+* @see LcdDisplay_IsComplete
+* @see LcdDisplay_OnComplete
+******************************************************************************/
+extern LcdDisplaySeq_t
+LcdDisplay_GetSeq(const LcdDisplay_t Display)
+{
+  if(!(Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  return gLastSeq[Display];
+}
+
+/******************************************************************************
+* Function : LcdDisplay_IsComplete()
+*//**
+* \b Description: Check if a sequence number reached the display<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Seq The sequence number given by a write or LcdDisplay_GetSeq.
+* @return uint8_t 1 if it's complete, 0 otherwise
+*
+* @see LcdDisplay_GetSeq
+******************************************************************************/
+extern uint8_t
+LcdDisplay_IsComplete(const LcdDisplay_t Display, const LcdDisplaySeq_t Seq)
+{
+  if(!(Display < LCD_DISPLAY_MAX &&
+       (Seq >> LCD_DISPLAY_SEQ_LANE_SHIFT) < LCD_LANE_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  LcdLane_t Lane = (LcdLane_t)(Seq >> LCD_DISPLAY_SEQ_LANE_SHIFT);
+  uint32_t Position;
+  uint32_t Behind;
+  uint8_t CtrlId;
+
+  for(CtrlId = 0; CtrlId < LCD_DISPLAY_CTRL_MAX; CtrlId++)
+    {
+      Position = (uint32_t)(Seq >> (LCD_DISPLAY_SEQ_POS_BITS * CtrlId));
+      Behind = (gCtrl[Display][CtrlId].Latched[Lane] - Position) &
+       LCD_DISPLAY_SEQ_POS_MASK;
+
+      //a latched count at or past the position (modulo the wrap-around)
+      if(!(Behind < LCD_DISPLAY_SEQ_POS_HALF)) return 0;
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_OnComplete()
+*//**
+* \b Description: Register a callback that LcdDisplay_Update invokes once
+* a sequence number reached the display. The callback may write to the 
+* display to chain the next update.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Seq The sequence number given by a write or LcdDisplay_GetSeq.
+* @param Callback The callback.
+* @return uint8_t 1 if the callback is registered, 0 otherwise (no free entry)
+*
+* @see LcdDisplay_GetSeq
+******************************************************************************/
+extern uint8_t
+LcdDisplay_OnComplete(const LcdDisplay_t Display,
+                      const LcdDisplaySeq_t Seq,
+                      const LcdDisplayCallback_t Callback)
+{
+  if(!(Display < LCD_DISPLAY_MAX && Callback != 0x00 &&
+       (Seq >> LCD_DISPLAY_SEQ_LANE_SHIFT) < LCD_LANE_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint8_t Fence;
+
+  for(Fence = 0; Fence < LCD_DISPLAY_FENCE_MAX; Fence++)
+    {
+      if(gFences[Display][Fence].Callback == 0x00)
+        {
+          gFences[Display][Fence].Seq = Seq;
+          gFences[Display][Fence].Callback = Callback;
+          gFenceCount[Display]++;
+          gAnyWork = 1;
+          return 1;
+        }
+    }
+
+  return 0;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Notify()
+*//**
+* \b Description: Utility function to invoke the callbacks of the complete 
+* sequence numbers of a display<br/>
+* @param Display The id of the display.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Notify(LcdDisplay_t Display)
+{
+  uint8_t Fence;
+  LcdDisplaySeq_t Seq;
+  LcdDisplayCallback_t Callback;
+
+  for(Fence = 0; Fence < LCD_DISPLAY_FENCE_MAX; Fence++)
+    {
+      Callback = gFences[Display][Fence].Callback;
+      Seq = gFences[Display][Fence].Seq;
+
+      if(Callback != 0x00 && LcdDisplay_IsComplete(Display, Seq) == 1)
+        {
+          //free the entry first so the callback can register a new one
+          gFences[Display][Fence].Callback = 0x00;
+          gFenceCount[Display]--;
+          Callback(Display, Seq);
+        }
+    }
+}
+
+#if LCD_DISPLAY_LATENCY == 1
+/******************************************************************************
+* Function : LcdDisplay_SetTickSource()
+*//**
+* \b Description: Set the tick source of the latency measurement. Every 
+* write that enqueues bytes (in any lane: LcdDisplay_SetData, 
+* LcdDisplay_SetDataAt, LcdDisplay_SetCursor, LcdDisplay_Clear, 
+* LcdDisplay_SetUrgent, LcdDisplay_CreateChar and LcdDisplay_EndFrame) is
+* timestamped when it's enqueued and measured by the LcdDisplay_Update 
+* that sends its last byte, so the resolution is an update. The writes 
+* inside a frame are measured from LcdDisplay_EndFrame.<br/>
+* @param Ticks The tick source (a free-running counter), 0 to stop the 
+* measurement.
+* @return void 
+*
+* \b Example:
+* @code
+* LcdDisplay_SetTickSource(Systick_GetTicks); //1 ms ticks
+* ...
+* LcdDisplay_GetLatency(LCD_DISPLAY_0, &Latency);
+* //Latency.Max < 100 meets the 100 ms budget
+* @endcode
+*
+* @see LcdDisplay_GetLatency
+******************************************************************************/
+extern void
+LcdDisplay_SetTickSource(const LcdDisplayTicks_t Ticks)
+{
+  gTicks = Ticks;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetLatency()
+*//**
+* \b Description: Get the latency histogram of a display<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Latency a valid pointer to the histogram to fill.
+* @return uint8_t 1 if the histogram is filled, 0 otherwise
+*
+* @see LcdDisplay_SetTickSource
+******************************************************************************/
+extern uint8_t
+LcdDisplay_GetLatency(const LcdDisplay_t Display,
+                      LcdDisplayLatency_t* const Latency)
+{
+  if(!(Latency != 0x00 && Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  *Latency = gLatency[Display];
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_ResetLatency()
+*//**
+* \b Description: Clear the latency histogram of a display. The writes 
+* waiting for their measurement are still measured.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @return void 
+******************************************************************************/
+extern void
+LcdDisplay_ResetLatency(const LcdDisplay_t Display)
+{
+  if(!(Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return;
+    }
+
+  uint8_t Bucket;
+
+  for(Bucket = 0; Bucket < LCD_DISPLAY_LATENCY_BUCKETS; Bucket++)
+    {
+      gLatency[Display].Buckets[Bucket] = 0;
+    }
+  gLatency[Display].Count = 0;
+  gLatency[Display].Max = 0;
+  gLatency[Display].Dropped = 0;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Stamp()
+*//**
+* \b Description: Utility function to timestamp the last write to a display
+* for its latency measurement<br/>
+* @param Display The id of the display.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Stamp(LcdDisplay_t Display)
+{
+  uint8_t Stamp;
+
+  if(gTicks == 0x00) return;
+
+  for(Stamp = 0; Stamp < LCD_DISPLAY_LATENCY_STAMPS; Stamp++)
+    {
+      if(gStamps[Display][Stamp].Used == 0)
+        {
+          gStamps[Display][Stamp].Seq = gLastSeq[Display];
+          gStamps[Display][Stamp].Tick = gTicks();
+          gStamps[Display][Stamp].Used = 1;
+          gStampCount[Display]++;
+          return;
+        }
+    }
+
+  gLatency[Display].Dropped++;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Measure()
+*//**
+* \b Description: Utility function to add the latency of the complete 
+* timestamped writes of a display to its histogram<br/>
+* @param Display The id of the display.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Measure(LcdDisplay_t Display)
+{
+  LcdDisplayLatency_t* const Latency = &gLatency[Display];
+  LcdStamp_t* Stamp;
+  uint32_t Now;
+  uint32_t Ticks;
+  uint8_t Bucket;
+  uint8_t i;
+
+  if(gTicks == 0x00) return;
+
+  Now = gTicks();
+
+  for(i = 0; i < LCD_DISPLAY_LATENCY_STAMPS; i++)
+    {
+      Stamp = &gStamps[Display][i];
+
+      if(!(Stamp->Used == 1 && LcdDisplay_IsComplete(Display, Stamp->Seq) == 1))
+        {
+          continue;
+        }
+
+      Ticks = Now - Stamp->Tick;
+      Stamp->Used = 0;
+      gStampCount[Display]--;
+
+      //the bit length of the latency
+      Bucket = 0;
+      while((Ticks >> Bucket) != 0 && Bucket < LCD_DISPLAY_LATENCY_BUCKETS - 1)
+        {
+          Bucket++;
+        }
+
+      Latency->Buckets[Bucket]++;
+      Latency->Count++;
+      if(Ticks > Latency->Max)
+        {
+          Latency->Max = Ticks;
+        }
+    }
+}
+#endif
+
+
+/******************************************************************************
+* Function : LcdDisplay_SetData()
+*//**
+* \b Description: Set data in Lcd buffer to show it. Inside a frame or once 
+* a frame is committed, the data is written into the frame at the frame 
+* cursor and clipped at the end of the row<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Data A pointer to the data to show.
+* @param DataSize The number of characters to send
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
+* @return uint8_t how many characters are sent
+******************************************************************************/
+extern uint8_t 
+LcdDisplay_SetData(const LcdDisplay_t Display,
+                   const uint8_t* const Data,
+                   const uint8_t DataSize,
+                   LcdDisplaySeq_t* const Seq)
+{
+  if(!(Data != 0x00 && Display < LCD_DISPLAY_MAX))
+  {
+    //TODO: Handle this error
+    return 0;
+  }
+
+  uint8_t Written;
+
+  if(gFrame[Display].Staging == 1 || gFrame[Display].Committed == 1)
+    {
+      Written = LcdDisplay_FrameWrite(Display, Data, DataSize);
+      LcdDisplay_Ticket(Display, LCD_LANE_FRAME, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+      //a staged write is measured from LcdDisplay_EndFrame
+      if(Written != 0 && gFrame[Display].Staging == 0)
+        {
+          LcdDisplay_Stamp(Display);
+        }
+#endif
+
+      return Written;
+    }
+
+  Written = LcdDisplay_PushText(Display, gCtrlSel[Display], LCD_LANE_NORMAL,
+   gCursorRow[Display], gCursorCol[Display], Data, DataSize);
+  LcdDisplay_Ticket(Display, LCD_LANE_NORMAL, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  if(Written != 0)
+    {
+      LcdDisplay_Stamp(Display);
+    }
+#endif
+
+  if(gCursorCol[Display] + Written > gConfig[Display].Width)
+    {
+      gCursorCol[Display] = gConfig[Display].Width;
+    }
+  else
+    {
+      gCursorCol[Display] += Written;
+    }
+
+  return Written;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SetDataAt()
+*//**
+* \b Description: Write characters at a position, clipped at the end of the
+* row. Neither the cursor of LcdDisplay_SetData nor the frame cursor moves,
+* so independent writers (like the regions of lcd_region.h) can share a 
+* display.<br/>
+* Inside a frame or once a frame is committed, the characters are written 
+* into the frame. Otherwise they're enqueued like LcdDisplay_SetData, all or
+* nothing, and the address counter is brought back to the cursor of 
+* LcdDisplay_SetData; the display doesn't switch to frames.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Row The row of the first character. It starts from zero.
+* @param Col The column of the first character. It starts from zero.
+* @param Data A pointer to the characters.
+* @param DataSize The number of characters.
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
+* @return uint8_t how many characters are written, 0 if they don't fit in
+* the buffer
+******************************************************************************/
+extern uint8_t
+LcdDisplay_SetDataAt(const LcdDisplay_t Display,
+                     const uint8_t Row,
+                     const uint8_t Col,
+                     const uint8_t* const Data,
+                     const uint8_t DataSize,
+                     LcdDisplaySeq_t* const Seq)
+{
+  if(!(Data != 0x00 && Display < LCD_DISPLAY_MAX &&
+       Row < gConfig[Display].Height &&
+       Col < gConfig[Display].Width))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  const uint8_t Width = gConfig[Display].Width;
+  uint8_t Size = DataSize;
+  uint8_t Written;
+  uint8_t Location;
+  uint8_t Ctrl;
+  uint8_t Restore;
+
+  if(gFrame[Display].Staging == 1)
+    {
+      LcdDisplay_Ticket(Display, LCD_LANE_FRAME, Seq);
+      return LcdDisplay_FrameStore(Display, gBackFrame[Display], Row, Col,
+       Data, DataSize);
+    }
+
+  if(gFrame[Display].Committed == 1)
+    {
+      Written = LcdDisplay_FrameStore(Display, gFrontFrame[Display], Row, Col,
+       Data, DataSize);
+      if(Written != 0)
+        {
+          LcdDisplay_FrameDirty(Display);
+        }
+      LcdDisplay_Ticket(Display, LCD_LANE_FRAME, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+      if(Written != 0)
+        {
+          LcdDisplay_Stamp(Display);
+        }
+#endif
+
+      return Written;
+    }
+
+  if(Size > Width - Col)
+    {
+      Size = Width - Col;
+    }
+
+  Location = LcdDisplay_GetLocation(Display, Row, Col);
+  Ctrl = (Location & LCD_DISPLAY_LOC_CTRL) != 0;
+  Restore = (Ctrl == gCtrlSel[Display]);
+
+  //the cursor commands (2 bytes each), the characters with their escapes 
+  //and the command bringing back the cursor of LcdDisplay_SetData must fit
+  if((uint16_t)CircBuff_GetFree(&gCtrl[Display][Ctrl].Buff[LCD_LANE_NORMAL]) <
+     (uint16_t)Size + LcdDisplay_CountEscapes(Data, Size) +
+     2 * (LcdDisplay_CountRuns(Display, Col, Size) + Restore))
+    {
+      return 0;
+    }
+
+  (void)LcdDisplay_PushCommand(Display, Ctrl, LCD_LANE_NORMAL,
+   (Location & LCD_DISPLAY_LOC_ADDRESS) | LCD_DISPLAY_DDRAM_MASK);
+  Written = LcdDisplay_PushText(Display, Ctrl, LCD_LANE_NORMAL, Row, Col,
+   Data, Size);
+
+  if(Restore == 1)
+    {
+      (void)LcdDisplay_PushCommand(Display, Ctrl, LCD_LANE_NORMAL,
+       LcdDisplay_GetCursorCommand(Display));
+    }
+
+  LcdDisplay_Ticket(Display, LCD_LANE_NORMAL, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  LcdDisplay_Stamp(Display);
+#endif
+
+  return Written;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SetUtf8()
+*//**
+* \b Description: Set UTF-8 text in Lcd buffer to show it, like 
+* LcdDisplay_SetData. Each code point is mapped to the codes of the 
+* character ROM of the display (see LcdCharset_Map). A code point that the
+* ROM lacks is shown through a CGRAM character: its glyph (see 
+* LcdCharset_FindGlyph) is uploaded once into one of the last 
+* LCD_DISPLAY_GLYPH_SLOTS characters and reused after that. It's shown as 
+* '?' if there's no glyph or no free character. The code points below 
+* U+0020 are the CGRAM characters.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Text A pointer to the UTF-8 text.
+* @param TextSize The number of bytes of the text.
+* @param Seq A pointer to store the sequence number of the last codes sent
+* (see LcdDisplay_IsComplete), 0x00 if it isn't needed.
+* @return uint8_t how many bytes of the text are sent. A character is sent 
+* once all its codes are.
+*
+* \b Example:
+* @code
+* //"23.5°C" with the degree sign of the ROM
+* (void)LcdDisplay_SetUtf8(LCD_DISPLAY_0, (const uint8_t*)"23.5\xC2\xB0" "C", 7,
+*  0x00);
+* @endcode
+******************************************************************************/
+extern uint8_t
+LcdDisplay_SetUtf8(const LcdDisplay_t Display,
+                   const uint8_t* const Text,
+                   const uint8_t TextSize,
+                   LcdDisplaySeq_t* const Seq)
+{
+  if(!(Text != 0x00 && Display < LCD_DISPLAY_MAX))
+  {
+    //TODO: Handle this error
+    return 0;
+  }
+
+  uint8_t Codes[LCD_DISPLAY_UTF8_CHUNK];
+  uint8_t Ends[LCD_DISPLAY_UTF8_CHUNK]; /* the text used by each code */
+  uint8_t Count = 0;
+  uint8_t Offset = 0;
+  uint8_t Used = 0;
+  uint8_t Mapped;
+  uint8_t Size;
+  uint32_t CodePoint;
+
+  while(Offset < TextSize)
+    {
+      Size = LcdCharset_Decode(&Text[Offset], TextSize - Offset, &CodePoint);
+      Mapped = LcdCharset_Map(gConfig[Display].Rom, CodePoint, &Codes[Count]);
+
+      if(Mapped == 0)
+        {
+          //an upload moves the address counter, the codes before it go first
+          if(LcdDisplay_WriteCodes(Display, Codes, Ends, &Count, &Used,
+             Seq) == 0)
+            {
+              return Used;
+            }
+
+          Codes[0] = LcdDisplay_GetGlyph(Display, CodePoint);
+          Mapped = 1;
+        }
+
+      //a kana with a sound mark is used once its second code is sent
+      Ends[Count] = Offset;
+      Offset += Size;
+      Ends[Count + Mapped - 1] = Offset;
+      Count += Mapped;
+
+      if(Count > LCD_DISPLAY_UTF8_CHUNK - LCD_CHARSET_CODES_MAX)
+        {
+          if(LcdDisplay_WriteCodes(Display, Codes, Ends, &Count, &Used,
+             Seq) == 0)
+            {
+              return Used;
+            }
+        }
+    }
+
+  (void)LcdDisplay_WriteCodes(Display, Codes, Ends, &Count, &Used, Seq);
+
+  return Used;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_WriteCodes()
+*//**
+* \b Description: Utility function to send the mapped codes of 
+* LcdDisplay_SetUtf8 and empty them<br/>
+* @param Display The id of the display.
+* @param Codes A pointer to the codes.
+* @param Ends A pointer to the text used by each code.
+* @param Count A pointer to the number of codes. It's set to 0.
+* @param Used A pointer to the text used. It's moved past the sent codes.
+* @param Seq A pointer to store the sequence number of the codes, 0x00 if it
+* isn't needed.
+* @return uint8_t 1 if all the codes are sent, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_WriteCodes(LcdDisplay_t Display, const uint8_t* const Codes,
+ const uint8_t* const Ends, uint8_t* const Count, uint8_t* const Used,
+ LcdDisplaySeq_t* const Seq)
+{
+  uint8_t Written;
+  uint8_t res;
+
+  if(*Count == 0) return 1;
+
+  Written = LcdDisplay_SetData(Display, Codes, *Count, Seq);
+  if(Written != 0)
+    {
+      *Used = Ends[Written - 1];
+    }
+
+  res = (Written == *Count);
+  *Count = 0;
+
+  return res;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetGlyph()
+*//**
+* \b Description: Utility function to get the CGRAM character of a code 
+* point missing from the character ROM. The glyph is uploaded into a free
+* character the first time, then the address counter is brought back to the
+* buffered cursor.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param CodePoint The code point.
+* @return uint8_t the CGRAM character, LCD_DISPLAY_MISSING if there's no 
+* glyph, no free character or no room to upload it
+******************************************************************************/
+static uint8_t
+LcdDisplay_GetGlyph(LcdDisplay_t Display, uint32_t CodePoint)
+{
+  const uint8_t IsFrame = (gFrame[Display].Staging == 1 ||
+   gFrame[Display].Committed == 1);
+  const uint8_t* Bitmap;
+  uint8_t Free = LCD_DISPLAY_GLYPH_SLOTS;
+  uint8_t Slot;
+  uint8_t CtrlId;
+
+  for(Slot = 0; Slot < LCD_DISPLAY_GLYPH_SLOTS; Slot++)
+    {
+      if(gGlyphCode[Display][Slot] == CodePoint)
+        {
+          return LCD_DISPLAY_GLYPH_FIRST + Slot;
+        }
+
+      if(gGlyphCode[Display][Slot] == 0 && Free == LCD_DISPLAY_GLYPH_SLOTS)
+        {
+          Free = Slot;
+        }
+    }
+
+  Bitmap = LcdCharset_FindGlyph(CodePoint);
+
+  //the cursor can't be brought back past the end of the row, the character
+  //isn't shown anyway
+  if(Bitmap == 0x00 || Free == LCD_DISPLAY_GLYPH_SLOTS ||
+     (IsFrame == 0 && gCursorCol[Display] >= gConfig[Display].Width))
+    {
+      return LCD_DISPLAY_MISSING;
+    }
+
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      if(CircBuff_GetFree(&gCtrl[Display][CtrlId].Buff[LCD_LANE_NORMAL]) <
+         LCD_DISPLAY_GLYPH_BYTES)
+        {
+          return LCD_DISPLAY_MISSING;
+        }
+    }
+
+  (void)LcdDisplay_CreateChar(Display, LCD_DISPLAY_GLYPH_FIRST + Free,
+   Bitmap, 0x00);
+  gGlyphCode[Display][Free] = CodePoint;
+
+  //the frames set the address of every cell they write
+  if(IsFrame == 0)
+    {
+      (void)LcdDisplay_SetCursor(Display, gCursorRow[Display],
+       gCursorCol[Display], 0x00);
+    }
+
+  return LCD_DISPLAY_GLYPH_FIRST + Free;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_CountEscapes()
+*//**
+* \b Description: Utility function to count the characters from 0x80, each
+* of them takes an extra byte (LCD_DISPLAY_DATA_ID) in a buffer<br/>
+* @param Data A pointer to the characters.
+* @param DataSize The number of characters.
+* @return uint8_t the number of characters from 0x80
+******************************************************************************/
+static uint8_t
+LcdDisplay_CountEscapes(const uint8_t* const Data, uint8_t DataSize)
+{
+  uint8_t Count = 0;
+  uint8_t i;
+
+  for(i = 0; i < DataSize; i++)
+    {
+      Count += (Data[i] & LCD_DISPLAY_CMD_ID) != 0;
+    }
+
+  return Count;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SetUrgent()
+*//**
+* \b Description: Set data in the high-priority lane of the display, e.g. an
+* alarm banner. The message is clipped at the end of the row. The lane is 
+* serviced before the normal buffer so, whatever is queued there, the 
+* message reaches the display after at most (Size + Runs) updates: Size 
+* characters once clipped and a cursor command per DDRAM run they cross 
+* (see LcdDisplay_GetSize and the geometry of the display). The address 
+* counter of the normal buffer is saved and restored around the message, 
+* which takes one more update before the normal buffer goes on. The 
+* message is enqueued all or nothing.<br/>
+* If frames are in use, the message is also applied to them so that the 
+* frame flushing doesn't overwrite it.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Row The row of the message. It starts from zero.
+* @param Col The column of the message. It starts from zero.
+* @param Data A pointer to the data to show.
+* @param DataSize The number of characters to send
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
+* @return uint8_t 1 if the message is enqueued, 0 otherwise
+******************************************************************************/
+extern uint8_t
+LcdDisplay_SetUrgent(const LcdDisplay_t Display,
+                     const uint8_t Row,
+                     const uint8_t Col,
+                     const uint8_t* const Data,
+                     const uint8_t DataSize,
+                     LcdDisplaySeq_t* const Seq)
+{
+  if(!(Data != 0x00 && Display < LCD_DISPLAY_MAX &&
+       Row < gConfig[Display].Height &&
+       Col < gConfig[Display].Width))
+  {
+    //TODO: Handle this error
+    return 0;
+  }
+
+  const uint8_t Width = gConfig[Display].Width;
+  const uint8_t Location = LcdDisplay_GetLocation(Display, Row, Col);
+  const uint8_t Ctrl = (Location & LCD_DISPLAY_LOC_CTRL) != 0;
+  CircBuff_t* Buff = &gCtrl[Display][Ctrl].Buff[LCD_LANE_URGENT];
+  uint8_t Size = DataSize;
+
+  if(Size > Width - Col)
+    {
+      Size = Width - Col;
+    }
+
+  //the cursor commands (2 bytes each) and the whole message (with the 
+  //escapes of the characters from 0x80) must fit
+  if((uint16_t)CircBuff_GetFree(Buff) <
+     (uint16_t)Size + LcdDisplay_CountEscapes(Data, Size) +
+     2 * LcdDisplay_CountRuns(Display, Col, Size))
+    {
+      return 0;
+    }
+
+  (void)LcdDisplay_PushCommand(Display, Ctrl, LCD_LANE_URGENT,
+   (Location & LCD_DISPLAY_LOC_ADDRESS) | LCD_DISPLAY_DDRAM_MASK);
+  (void)LcdDisplay_PushText(Display, Ctrl, LCD_LANE_URGENT, Row, Col, Data,
+   Size);
+
+  if(gFrame[Display].Staging == 1)
+    {
+      (void)LcdDisplay_FrameStore(Display, gBackFrame[Display], Row, Col,
+       Data, Size);
+    }
+
+  if(gFrame[Display].Committed == 1)
+    {
+      (void)LcdDisplay_FrameStore(Display, gFrontFrame[Display], Row, Col,
+       Data, Size);
+    }
+
+  LcdDisplay_Ticket(Display, LCD_LANE_URGENT, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  LcdDisplay_Stamp(Display);
+#endif
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Update()
+*//**
+* \b Description: When this function is called, it send a new byte 
+* representing a command or a data to each display with pending work. 
+* Transports that batch bus transfers get up to their burst of bytes, 
+* unless a slow command (clear/return home) is sent. The two controllers of
+* a 40x4 display are serviced in turn so they execute in parallel. 
+* It returns immediately if nothing was written since all the displays
+* became idle, unless a display is scrubbed: the DDRAM of an idle display 
+* with a ScrubBudget is then read back and repaired (see 
+* LcdDisplay_Scrub).<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* \b POST-CONDITION: The new data/command is sent to LCDs and the callbacks
+* of the complete sequence numbers are invoked <br/>
+* @return uint32_t a bitmask of the displays that still have pending work 
+* (bit n for display n). 0 means the task can sleep until the next write,
+* unless a display is scrubbed or animated (see LcdDisplay_HasWork).
+*
+* \b Example:
+* @code
+* if(LcdDisplay_HasWork() == 1)
+*   {
+*     (void)LcdDisplay_Update();
+*   }
+* @endcode
+*
+* @see LcdDisplay_HasWork
+******************************************************************************/
+extern uint32_t 
+LcdDisplay_Update(void)
+{
+  LcdDisplay_t Display;
+  const LcdTransport_t* Transport;
+  uint8_t Sent;
+  uint8_t CtrlId;
+  uint8_t Active;
+  uint32_t Pending = 0;
+
+  if(gAnyWork == 0 && gScrubbing == 0 && gAnimations == 0) return 0;
+
+  //cleared first so that a write during the loop isn't lost
+  gAnyWork = 0;
+
+  for(Display = LCD_DISPLAY_0; Display < LCD_DISPLAY_MAX; Display++)
+    {
+      Transport = LcdDisplay_GetTransport(Display);
+
+      if(gAnimCount[Display] != 0)
+        {
+          LcdDisplay_StepAnimations(Display);
+        }
+
+      if(LcdDisplay_IsBusy(Display) == 0)
+        {
+          //the scrub only uses the updates of an idle display
+          if(LcdDisplay_CanScrub(Display) == 1)
+            {
+              LcdDisplay_Scrub(Display);
+
+              if(Transport->Flush != 0x00)
+                {
+                  Transport->Flush(&gConfig[Display]);
+                }
+            }
+
+          continue;
+        }
+
+      //a bit per controller that may take more bytes
+      Active = (uint8_t)((1 << gCtrlCount[Display]) - 1);
+
+      for(Sent = 0; Sent < Transport->Burst && Active != 0; Sent++)
+        {
+          for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+            {
+              if((Active & (1 << CtrlId)) == 0) continue;
+
+              gLongCommand = 0;
+
+              if(LcdDisplay_Service(Display, CtrlId) == 0 || gLongCommand == 1)
+                {
+                  Active &= (uint8_t)~(1 << CtrlId);
+                }
+            }
+        }
+
+      if(Transport->Flush != 0x00)
+        {
+          Transport->Flush(&gConfig[Display]);
+        }
+
+      if(gFenceCount[Display] != 0)
+        {
+          LcdDisplay_Notify(Display);
+        }
+
+#if LCD_DISPLAY_LATENCY == 1
+      if(gStampCount[Display] != 0)
+        {
+          LcdDisplay_Measure(Display);
+        }
+#endif
+
+      //the frame steps of an animation aren't pending work: they're
+      //reported by LcdDisplay_HasWork
+      if(LcdDisplay_IsBusy(Display) == 1)
+        {
+          Pending |= (uint32_t)1 << Display;
+        }
+    }
+
+  if(Pending != 0)
+    {
+      gAnyWork = 1;
+    }
+
+  return Pending;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_HasWork()
+*//**
+* \b Description: Check if any display may have pending work. It's cheap 
+* enough for a scheduler to call it before running the LCD task. A display
+* that is scrubbed (see LcdDisplay_Scrub) or has an animated character 
+* always has work, so the idle updates keep reading back its DDRAM and 
+* stepping its frames.<br/>
+* @return uint8_t 1 if LcdDisplay_Update has work to do, 0 otherwise
+*
+* @see LcdDisplay_Update
+******************************************************************************/
+extern uint8_t
+LcdDisplay_HasWork(void)
+{
+  return gAnyWork != 0 || gScrubbing != 0 || gAnimations != 0;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetPending()
+*//**
+* \b Description: Get the number of bytes waiting in the buffers (normal and
+* urgent) of all the controllers of a display. A committed frame that is 
+* not flushed yet is reported by LcdDisplay_Update but not counted here.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @return uint16_t the number of pending bytes
+******************************************************************************/
+extern uint16_t
+LcdDisplay_GetPending(const LcdDisplay_t Display)
+{
+  if(!(Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint16_t Pending = 0;
+  LcdCtrl_t* Ctrl;
+  uint8_t CtrlId;
+
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      Ctrl = &gCtrl[Display][CtrlId];
+      Pending += CircBuff_GetCount(&Ctrl->Buff[LCD_LANE_NORMAL]);
+      Pending += CircBuff_GetCount(&Ctrl->Buff[LCD_LANE_URGENT]);
+    }
+
+  return Pending;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetSize()
+*//**
+* \b Description: Get the size of a display from its configuration<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Width a valid pointer to store the characters per row in.
+* @param Height a valid pointer to store the rows in.
+* @return uint8_t 1 if the size is stored, 0 otherwise
+******************************************************************************/
+extern uint8_t
+LcdDisplay_GetSize(const LcdDisplay_t Display, uint8_t* const Width,
+ uint8_t* const Height)
+{
+  if(!(Display < LCD_DISPLAY_MAX && Width != 0x00 && Height != 0x00))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  *Width = gConfig[Display].Width;
+  *Height = gConfig[Display].Height;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetChanges()
+*//**
+* \b Description: Get the change counter of a display. It's incremented 
+* every time a byte that reaches the display changes its DDRAM or CGRAM, 
+* so a monitor can skip LcdDisplay_Snapshot while it's the same.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @return uint32_t the change counter
+******************************************************************************/
+extern uint32_t
+LcdDisplay_GetChanges(const LcdDisplay_t Display)
+{
+  if(!(Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  return gChanges[Display];
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Snapshot()
+*//**
+* \b Description: Get what a display shows from the shadows of its DDRAM and
+* CGRAM. They mirror the bytes that reached the display (not the pending 
+* ones), so nothing is read over the bus. From another thread than 
+* LcdDisplay_Update, the snapshot is consistent if the change counter is the
+* same before and after it.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Snapshot a valid pointer to the snapshot to fill.
+* @return uint8_t 1 if the snapshot is filled, 0 otherwise
+*
+* \b Example:
+* @code
+* static uint32_t Seen;
+* LcdDisplaySnapshot_t Screen;
+* if(LcdDisplay_GetChanges(LCD_DISPLAY_0) != Seen &&
+*    LcdDisplay_Snapshot(LCD_DISPLAY_0, &Screen) == 1)
+* {
+*   Seen = Screen.Changes;
+*   Diag_Report(Screen.Text, sizeof(Screen.Text));
+* }
+* @endcode
+******************************************************************************/
+extern uint8_t
+LcdDisplay_Snapshot(const LcdDisplay_t Display,
+                    LcdDisplaySnapshot_t* const Snapshot)
+{
+  if(!(Snapshot != 0x00 && Display < LCD_DISPLAY_MAX))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint8_t CtrlId;
+  uint8_t Byte;
+
+  Snapshot->Changes = gChanges[Display];
+  Snapshot->Width = gConfig[Display].Width;
+  Snapshot->Height = gConfig[Display].Height;
+  LcdDisplay_FrameFill(Snapshot->Text, LCD_DISPLAY_MAX_CELLS,
+   LCD_DISPLAY_BLANK);
+  LcdDisplay_FrameLoad(Display, Snapshot->Text);
+
+  for(CtrlId = 0; CtrlId < LCD_DISPLAY_CTRL_MAX; CtrlId++)
+    {
+      for(Byte = 0; Byte < LCD_DISPLAY_CGRAM_SIZE; Byte++)
+        {
+          Snapshot->Cgram[CtrlId][Byte] = gCtrl[Display][CtrlId].Cgram[Byte];
+        }
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_IsBusy()
+*//**
+* \b Description: Utility function to check if a display has pending work:
+* buffered bytes, an unflushed frame or pending callbacks<br/>
+* @param Display The id of the display.
+* @return uint8_t 1 if the display has pending work, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_IsBusy(LcdDisplay_t Display)
+{
+  const LcdCtrl_t* Ctrl;
+  uint8_t CtrlId;
+
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      Ctrl = &gCtrl[Display][CtrlId];
+
+      if(CircBuff_GetCount(&Ctrl->Buff[LCD_LANE_URGENT]) != 0 ||
+         CircBuff_GetCount(&Ctrl->Buff[LCD_LANE_NORMAL]) != 0 ||
+         Ctrl->Dirty == 1 || Ctrl->Glyphs != 0)
+        {
+          return 1;
+        }
+    }
+
+  return gFenceCount[Display] != 0;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Service()
+*//**
+* \b Description: Utility function to send the next byte of a controller of
+* a display. The urgent lane is serviced first, then the animation frames,
+* then the normal buffer, then the committed frame. The address counter of
+* the normal buffer is restored before the normal buffer is resumed.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param CtrlId The controller.
+* @return uint8_t 1 if a byte is sent, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_Service(LcdDisplay_t Display, uint8_t CtrlId)
+{
+  LcdCtrl_t* Ctrl = &gCtrl[Display][CtrlId];
+  uint8_t Sent = 1;
+
+  if(CircBuff_GetCount(&Ctrl->Buff[LCD_LANE_URGENT]) != 0)
+    {
+      if(Ctrl->Preempted == 0)
+        {
+          Ctrl->SavedAddress = Ctrl->Address;
+          Ctrl->Preempted = 1;
+        }
+
+      Sent = LcdDisplay_SendNext(Display, CtrlId, LCD_LANE_URGENT);
+    }
+  else if(Ctrl->Glyphs != 0 && LcdDisplay_SendGlyph(Display, CtrlId) == 1)
+    {
+      //a row of an animation frame is sent
+    }
+  else if(CircBuff_GetCount(&Ctrl->Buff[LCD_LANE_NORMAL]) != 0)
+    {
+      if(Ctrl->Preempted == 1 && Ctrl->Address != Ctrl->SavedAddress)
+        {
+          LcdDisplay_Latch(Display, CtrlId, Ctrl->SavedAddress,
+           LCD_DATA_FLAG_CMD);
+        }
+      else
+        {
+          Sent = LcdDisplay_SendNext(Display, CtrlId, LCD_LANE_NORMAL);
+        }
+
+      Ctrl->Preempted = 0;
+    }
+  else if(Ctrl->Dirty == 1)
+    {
+      if(Ctrl->Preempted == 0)
+        {
+          Ctrl->SavedAddress = Ctrl->Address;
+          Ctrl->Preempted = 1;
+        }
+
+      Sent = LcdDisplay_SendFrame(Display, CtrlId);
+    }
+  else
+    {
+      Sent = 0;
+    }
+
+  return Sent;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SendNext()
+*//**
+* \b Description: Utility function to dequeue the next data/command from a
+* lane and send it to the display<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Lane The lane (normal or urgent).
+* @return uint8_t 1 if a byte is sent, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_SendNext(LcdDisplay_t Display, uint8_t Ctrl, LcdLane_t Lane)
+{
+  CircBuff_t* Buff = &gCtrl[Display][Ctrl].Buff[Lane];
+  LcdDataFlag_t Flag;
+  uint8_t Data;
+  uint8_t res;
+
+  // Find the next data/command
+  res = CircBuff_Dequeue(Buff, &Data);
+  if(res == 0) return 0;
+
+  //Is it data or command
+  if(Data == LCD_DISPLAY_CMD_ID || Data == LCD_DISPLAY_DATA_ID)
+    {
+      Flag = (Data == LCD_DISPLAY_CMD_ID) ? LCD_DATA_FLAG_CMD :
+       LCD_DATA_FLAG_DATA;
+
+      res = CircBuff_Dequeue(Buff, &Data);
+      if(res == 0)
+        {
+          //TODO: handle this error.
+          return 0;
+        }
+
+      LcdDisplay_Latch(Display, Ctrl, Data, Flag);
+      gCtrl[Display][Ctrl].Latched[Lane] += 2;
+    }
+  else
+    {
+      LcdDisplay_Latch(Display, Ctrl, Data, LCD_DATA_FLAG_DATA);
+      gCtrl[Display][Ctrl].Latched[Lane]++;
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SendFrame()
+*//**
+* \b Description: Utility function to send the next byte of the committed
+* frame to a controller. It looks for the next cell of the controller that 
+* differs from the display. If the address counter isn't already there, the
+* cursor is moved, otherwise the character is sent. The controller is marked
+* clean when no cell differs and the frame is complete once all the 
+* controllers are clean.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param CtrlId The controller.
+* @return uint8_t 1 if a byte is sent, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_SendFrame(LcdDisplay_t Display, uint8_t CtrlId)
+{
+  LcdCtrl_t* Ctrl = &gCtrl[Display][CtrlId];
+  const uint8_t Cells = gConfig[Display].Width * gConfig[Display].Height;
+  uint8_t Cell = Ctrl->Scan;
+  uint8_t Checked;
+  uint8_t Location = 0;
+
+  for(Checked = 0; Checked < Cells; Checked++)
+    {
+      Location = gLocation[Display][Cell];
+
+      if(((Location & LCD_DISPLAY_LOC_CTRL) != 0) == CtrlId &&
+         gFrontFrame[Display][Cell] !=
+         Ctrl->Ddram[LcdDisplay_DdramIndex(Location)])
+        {
+          break;
+        }
+
+      Cell++;
+      if(Cell == Cells) Cell = 0;
+    }
+
+  if(Checked == Cells)
+    {
+      Ctrl->Dirty = 0;
+
+      for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+        {
+          if(gCtrl[Display][CtrlId].Dirty == 1) return 0;
+        }
+
+      Ctrl = &gCtrl[Display][0];
+      Ctrl->Latched[LCD_LANE_FRAME] = Ctrl->Enqueued[LCD_LANE_FRAME];
+      return 0;
+    }
+
+  Ctrl->Scan = Cell;
+  Location = (Location & LCD_DISPLAY_LOC_ADDRESS) | LCD_DISPLAY_DDRAM_MASK;
+
+  if(Ctrl->Address != Location)
+    {
+      LcdDisplay_Latch(Display, CtrlId, Location, LCD_DATA_FLAG_CMD);
+    }
+  else
+    {
+      LcdDisplay_Latch(Display, CtrlId, gFrontFrame[Display][Cell],
+       LCD_DATA_FLAG_DATA);
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_StepAnimations()
+*//**
+* \b Description: Utility function to count an update for the animated 
+* characters of a display. A character whose period elapsed moves to its 
+* next frame and is marked for upload on every controller. The period of a
+* frame starts once it's uploaded so that a slow bus slows the animation 
+* down instead of starving the normal buffer.<br/>
+* @param Display The id of the display.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_StepAnimations(LcdDisplay_t Display)
+{
+  LcdAnim_t* Anim;
+  uint8_t CharIndex;
+  uint8_t CtrlId;
+
+  for(CharIndex = 0; CharIndex < LCD_DISPLAY_CGRAM_CHARS; CharIndex++)
+    {
+      Anim = &gAnim[Display][CharIndex];
+      if(Anim->Frames == 0x00) continue;
+
+      //the period starts once the frame is uploaded to all the controllers
+      for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+        {
+          if(gCtrl[Display][CtrlId].Glyphs & (1 << CharIndex)) break;
+        }
+      if(CtrlId < gCtrlCount[Display]) continue;
+
+      Anim->Ticks--;
+      if(Anim->Ticks != 0) continue;
+
+      Anim->Ticks = Anim->Period;
+      Anim->Frame++;
+      if(Anim->Frame == Anim->Count) Anim->Frame = 0;
+
+      for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+        {
+          gCtrl[Display][CtrlId].Glyphs |= (uint8_t)(1 << CharIndex);
+        }
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SendGlyph()
+*//**
+* \b Description: Utility function to send the next byte of the animation 
+* frames to a controller. It looks for the next CGRAM row that differs from
+* the frame shown, like LcdDisplay_SendFrame does for the DDRAM: the address
+* is set if the address counter isn't already there, otherwise the row is 
+* sent. Only the rows that change between two frames are sent and 
+* consecutive rows share one address command.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param CtrlId The controller.
+* @return uint8_t 1 if a byte is sent, 0 if all the frames are uploaded
+******************************************************************************/
+static uint8_t
+LcdDisplay_SendGlyph(LcdDisplay_t Display, uint8_t CtrlId)
+{
+  LcdCtrl_t* Ctrl = &gCtrl[Display][CtrlId];
+  const LcdAnim_t* Anim;
+  const uint8_t* Bitmap;
+  uint8_t CharIndex;
+  uint8_t Row;
+  uint8_t Address;
+
+  for(CharIndex = 0; CharIndex < LCD_DISPLAY_CGRAM_CHARS; CharIndex++)
+    {
+      if((Ctrl->Glyphs & (1 << CharIndex)) == 0) continue;
+
+      Anim = &gAnim[Display][CharIndex];
+
+      if(Anim->Frames != 0x00)
+        {
+          Bitmap = &Anim->Frames[Anim->Frame * LCD_DISPLAY_CGRAM_ROWS];
+
+          for(Row = 0; Row < LCD_DISPLAY_CGRAM_ROWS; Row++)
+            {
+              Address = (uint8_t)(CharIndex * LCD_DISPLAY_CGRAM_ROWS + Row);
+              if(Bitmap[Row] != Ctrl->Cgram[Address] ||
+                 (Ctrl->Stale[CharIndex] & (1 << Row)) != 0) break;
+            }
+
+          if(Row < LCD_DISPLAY_CGRAM_ROWS)
+            {
+              if(Ctrl->Preempted == 0)
+                {
+                  Ctrl->SavedAddress = Ctrl->Address;
+                  Ctrl->Preempted = 1;
+                }
+
+              Address |= LCD_DISPLAY_CGRAM_MASK;
+
+              if(Ctrl->Address != Address)
+                {
+                  LcdDisplay_Latch(Display, CtrlId, Address, LCD_DATA_FLAG_CMD);
+                }
+              else
+                {
+                  LcdDisplay_Latch(Display, CtrlId, Bitmap[Row],
+                   LCD_DATA_FLAG_DATA);
+                }
+
+              return 1;
+            }
+        }
+
+      Ctrl->Glyphs &= (uint8_t)~(1 << CharIndex);
+    }
+
+  return 0;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_CanScrub()
+*//**
+* \b Description: Utility function to check if the DDRAM of a display is 
+* scrubbed: it has a scrub budget and its transport can read back<br/>
+* @param Display The id of the display.
+* @return uint8_t 1 if the display is scrubbed, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplay_CanScrub(LcdDisplay_t Display)
+{
+  return gConfig[Display].ScrubBudget != 0 && gCtrlCount[Display] != 0 &&
+   LcdDisplay_GetTransport(Display)->Read != 0x00;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Scrub()
+*//**
+* \b Description: Utility function to read back the DDRAM of an idle 
+* display and repair it. Cell by cell, the address is set, the char is read
+* and compared against the DDRAM shadow, and it's rewritten if it differs.
+* Every step starts with a status read: the step waits for the next update
+* while the controller is busy, and an address counter that doesn't match 
+* its shadow means the controller lost its mode (e.g. it's back in the 8-bit
+* mode after a glitch) so it's initialized again. A controller that stays 
+* busy for LCD_DISPLAY_SCRUB_STALL updates is initialized again too.<br/>
+* At most ScrubBudget steps are taken per update. The address counter of the
+* normal buffer is restored before the buffer is resumed.<br/>
+* \b PRE-CONDITION: the display is idle and can be scrubbed <br/>
+* @param Display The id of the display.
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Scrub(LcdDisplay_t Display)
+{
+  const LcdTransport_t* const Transport = LcdDisplay_GetTransport(Display);
+  const uint8_t Cells = gConfig[Display].Width * gConfig[Display].Height;
+  LcdScrub_t* const Scrub = &gScrub[Display];
+  LcdCtrl_t* Ctrl;
+  uint8_t CtrlId;
+  uint8_t Location;
+  uint8_t Target;
+  uint8_t Counter;
+  uint8_t Status;
+  uint8_t Data;
+  uint8_t Step;
+
+  for(Step = 0; Step < gConfig[Display].ScrubBudget; Step++)
+    {
+      Location = gLocation[Display][Scrub->Cell];
+      CtrlId = (Location & LCD_DISPLAY_LOC_CTRL) != 0;
+      Ctrl = &gCtrl[Display][CtrlId];
+      Target = (Location & LCD_DISPLAY_LOC_ADDRESS) | LCD_DISPLAY_DDRAM_MASK;
+
+      Status = Transport->Read(&gConfig[Display], CtrlId, 0);
+
+      if(Status & LCD_DISPLAY_BUSY_FLAG)
+        {
+          Scrub->Stall++;
+          if(Scrub->Stall >= LCD_DISPLAY_SCRUB_STALL)
+            {
+              LcdDisplay_Reinit(Display, CtrlId);
+            }
+
+          return;
+        }
+
+      Scrub->Stall = 0;
+
+      //the address counter as the controller reports it
+      Counter = (Ctrl->Address & LCD_DISPLAY_DDRAM_MASK) ?
+       (Ctrl->Address & LCD_DISPLAY_LOC_ADDRESS) :
+       (Ctrl->Address & (LCD_DISPLAY_CGRAM_SIZE - 1));
+
+      if(Status != Counter)
+        {
+          LcdDisplay_Reinit(Display, CtrlId);
+          return;
+        }
+
+      if(Ctrl->Preempted == 0)
+        {
+          Ctrl->SavedAddress = Ctrl->Address;
+          Ctrl->Preempted = 1;
+        }
+
+      if(Ctrl->Address != Target ||
+         (Scrub->Repair == 0 && Scrub->Readable == 0))
+        {
+          LcdDisplay_Latch(Display, CtrlId, Target, LCD_DATA_FLAG_CMD);
+          continue;
+        }
+
+      if(Scrub->Repair == 1)
+        {
+          LcdDisplay_Latch(Display, CtrlId,
+           Ctrl->Ddram[LcdDisplay_DdramIndex(Target)], LCD_DATA_FLAG_DATA);
+          Scrub->Repair = 0;
+        }
       else
         {
-          LcdDisplay_SendByte(Display, Data, LCD_DATA_FLAG_DATA);
+          Data = Transport->Read(&gConfig[Display], CtrlId, 1);
+          Ctrl->Address = LcdDisplay_NextAddress(Ctrl->Address);
+
+          if(Data != Ctrl->Ddram[LcdDisplay_DdramIndex(Target)])
+            {
+              Scrub->Repair = 1;
+              continue;
+            }
         }
+
+      Scrub->Cell++;
+      if(Scrub->Cell == Cells) Scrub->Cell = 0;
     }
 }
 
 /******************************************************************************
-* Function : LcdDisplay_SendByte()
+* Function : LcdDisplay_Reinit()
 *//**
-* \b Description: Utility function to send a char to show or a command to
-* execute on the lcd display<br/>
-* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* \b Description: Utility function to initialize a controller again after 
+* the scrub detected a mode loss. The initialization commands (but the 
+* clear) go through the urgent lane, then the scrub repairs the cells that 
+* differ from the DDRAM shadow.<br/>
 * @param Display The id of the display.
-* @param Data the command/char
-* @param Flag A flag to differentiate between commands and data
+* @param Ctrl The controller.
 * @return void 
 ******************************************************************************/
 static void
-LcdDisplay_SendByte(LcdDisplay_t Display, uint8_t Data, LcdDataFlag_t Flag)
+LcdDisplay_Reinit(LcdDisplay_t Display, uint8_t Ctrl)
 {
-  if(!(Display < LCD_DISPLAY_MAX && Flag < LCD_DATA_FLAG_MAX))
+  CircBuff_t* Buff = &gCtrl[Display][Ctrl].Buff[LCD_LANE_URGENT];
+  uint8_t cmd;
+
+  gScrub[Display].Repair = 0;
+  gScrub[Display].Stall = 0;
+
+  //the identifier and the command of each of them
+  if(CircBuff_GetFree(Buff) < 2 * (sizeof(gInitCmds) - 1))
     {
       //TODO: handle this error
       return;
     }
 
-  uint8_t DataCh;
-  uint8_t Nibble;
+  for(cmd = 0; cmd < sizeof(gInitCmds) - 1; cmd++)
+    {
+      (void)LcdDisplay_PushCommand(Display, Ctrl, LCD_LANE_URGENT,
+       gInitCmds[cmd]);
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Latch()
+*//**
+* \b Description: Utility function to send a byte to the display and keep 
+* the shadows of its address counter and DDRAM up to date<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Data the command/char
+* @param Flag A flag to differentiate between commands and data
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Latch(LcdDisplay_t Display, uint8_t Ctrl, uint8_t Data,
+ LcdDataFlag_t Flag)
+{
+  LcdDisplay_SendByte(Display, Ctrl, Data, Flag);
+  LcdDisplay_Track(Display, Ctrl, Data, Flag);
+
+  gLongCommand = (Flag == LCD_DATA_FLAG_CMD &&
+   (Data == LCD_DISPLAY_CMD_CLEAR ||
+    (Data & (~0x01)) == LCD_DISPLAY_CMD_ADDRESS_RESET));
+
+  //the controller returns valid data after a set DDRAM address only
+  gScrub[Display].Readable = (Flag == LCD_DATA_FLAG_CMD &&
+   (Data & LCD_DISPLAY_DDRAM_MASK));
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Track()
+*//**
+* \b Description: Utility function to mirror the effect of a sent byte on the
+* address counter, the DDRAM and the CGRAM of a controller. It assumes the
+* increment entry mode and the 2-line DDRAM layout used by LcdDisplay_Init.
+* The change counter of the display counts the bytes that change.<br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Data the command/char
+* @param Flag A flag to differentiate between commands and data
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_Track(LcdDisplay_t Display, uint8_t Ctrl, uint8_t Data,
+ LcdDataFlag_t Flag)
+{
+  uint8_t* const Ddram = gCtrl[Display][Ctrl].Ddram;
+  uint8_t Address = gCtrl[Display][Ctrl].Address;
+  uint8_t* Cell;
+  uint8_t Index;
 
-  for(Nibble = 2; Nibble >= 1; Nibble--)
+  if(Flag == LCD_DATA_FLAG_DATA)
     {
-      for(DataCh = 0; DataCh < LCD_DISPLAY_BITLEN; DataCh++)
+      if(Address & LCD_DISPLAY_DDRAM_MASK)
         {
-          if(Data & (1 << (DataCh + (LCD_DISPLAY_BITLEN * (Nibble - 1)))))
-            {
-              Dio_ChannelWrite(gConfig[Display].Data[DataCh], DIO_STATE_HIGH);
-            }
-          else
-            {
-              Dio_ChannelWrite(gConfig[Display].Data[DataCh], DIO_STATE_LOW);
-            }
+          Cell = &Ddram[LcdDisplay_DdramIndex(Address)];
+        }
+      else
+        {
+          Index = Address & (LCD_DISPLAY_CGRAM_SIZE - 1);
+          Cell = &gCtrl[Display][Ctrl].Cgram[Index];
+          //the row is known once it's written
+          gCtrl[Display][Ctrl].Stale[Index / LCD_DISPLAY_CGRAM_ROWS] &=
+           (uint8_t)~(1 << (Index % LCD_DISPLAY_CGRAM_ROWS));
         }
 
-      if (Flag == LCD_DATA_FLAG_DATA)
+      if(*Cell != Data)
         {
-          Dio_ChannelWrite(gConfig[Display].Rs, DIO_STATE_HIGH);
+          *Cell = Data;
+          gChanges[Display]++;
         }
-      else
+
+      Address = LcdDisplay_NextAddress(Address);
+    }
+  else if((Data & LCD_DISPLAY_DDRAM_MASK) || (Data & LCD_DISPLAY_CGRAM_MASK))
+    {
+      Address = Data;
+    }
+  else if(Data == LCD_DISPLAY_CMD_CLEAR ||
+   (Data & (~0x01)) == LCD_DISPLAY_CMD_ADDRESS_RESET)
+    {
+      Address = LCD_DISPLAY_DDRAM_MASK | LCD_DISPLAY_DDRAM_LINE_0;
+
+      if(Data == LCD_DISPLAY_CMD_CLEAR)
         {
-          Dio_ChannelWrite(gConfig[Display].Rs, DIO_STATE_LOW);
+          LcdDisplay_FrameFill(Ddram, LCD_DISPLAY_DDRAM_SIZE,
+           LCD_DISPLAY_BLANK);
+          gChanges[Display]++;
         }
+    }
+
+  gCtrl[Display][Ctrl].Address = Address;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_NextAddress()
+*//**
+* \b Description: Utility function to get the address counter after a char
+* is written or read<br/>
+* @param Address The address counter shadow (a set DDRAM/CGRAM address 
+* command).
+* @return uint8_t the next address counter shadow
+******************************************************************************/
+static uint8_t
+LcdDisplay_NextAddress(uint8_t Address)
+{
+  if(!(Address & LCD_DISPLAY_DDRAM_MASK))
+    {
+      return LCD_DISPLAY_CGRAM_MASK |
+       ((Address + 1) & (LCD_DISPLAY_CGRAM_SIZE - 1));
+    }
+
+  //the end of line 0 continues at line 1 and vice versa
+  Address++;
+  if(Address == (LCD_DISPLAY_DDRAM_MASK |
+   (LCD_DISPLAY_DDRAM_LINE_0 + LCD_DISPLAY_DDRAM_LINE_LEN)))
+    {
+      Address = LCD_DISPLAY_DDRAM_MASK | LCD_DISPLAY_DDRAM_LINE_1;
+    }
+  else if(Address == (LCD_DISPLAY_DDRAM_MASK |
+   (LCD_DISPLAY_DDRAM_LINE_1 + LCD_DISPLAY_DDRAM_LINE_LEN)))
+    {
+      Address = LCD_DISPLAY_DDRAM_MASK | LCD_DISPLAY_DDRAM_LINE_0;
+    }
+
+  return Address;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_DdramIndex()
+*//**
+* \b Description: Utility function to get the index of a DDRAM address in 
+* the DDRAM shadow<br/>
+* @param Address The DDRAM address or location (the masks are ignored).
+* @return uint8_t the index in the DDRAM shadow
+******************************************************************************/
+static uint8_t
+LcdDisplay_DdramIndex(uint8_t Address)
+{
+  uint8_t Index = Address & (LCD_DISPLAY_DDRAM_LINE_1 - 1);
+
+  if(Address & LCD_DISPLAY_DDRAM_LINE_1)
+    {
+      Index = Index + LCD_DISPLAY_DDRAM_LINE_LEN;
+    }
+
+  return Index;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_SendByte()
+*//**
+* \b Description: Utility function to send a char to show or a command to
+* execute on a controller of the lcd display through its transport<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param Ctrl The controller.
+* @param Data the command/char
+* @param Flag A flag to differentiate between commands and data
+* @return void 
+******************************************************************************/
+static void
+LcdDisplay_SendByte(LcdDisplay_t Display, uint8_t Ctrl, uint8_t Data,
+ LcdDataFlag_t Flag)
+{
+  if(!(Display < LCD_DISPLAY_MAX && Flag < LCD_DATA_FLAG_MAX))
+    {
+      //TODO: handle this error
+      return;
+    }
+
+  LcdDisplay_GetTransport(Display)->Write(&gConfig[Display], Ctrl, Data,
+   Flag == LCD_DATA_FLAG_DATA);
+}
 
-      //latch
-      Dio_ChannelWrite(gConfig[Display].En, DIO_STATE_HIGH);
-      LcdDisplay_Delay();
-      Dio_ChannelWrite(gConfig[Display].En, DIO_STATE_LOW);
-      LcdDisplay_Delay();
+/******************************************************************************
+* Function : LcdDisplay_GetTransport()
+*//**
+* \b Description: Utility function to get the transport of a display<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @return const LcdTransport_t* the configured transport, the direct GPIO one
+* if none is configured
+******************************************************************************/
+static const LcdTransport_t*
+LcdDisplay_GetTransport(LcdDisplay_t Display)
+{
+  if(gConfig[Display].Transport == 0x00)
+    {
+      return &LcdTransport_Dio;
     }
+
+  return gConfig[Display].Transport;
 }
 
 /******************************************************************************
 * Function : LcdDisplay_SetCursor()
 *//**
-* \b Description: function to set the position of the cursor <br/>
+* \b Description: function to set the position of the cursor. On a 40x4 
+* display, it also selects the controller of the row for the next 
+* LcdDisplay_SetData. Inside a frame or once a frame is committed, it sets 
+* the frame cursor <br/>
 * \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
 * @param Display The id of the display.
 * @param Row The row of the cursor in the display. It starts from zero.
 * @param Row The column of the cursor in the display. It starts from zero.
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed.
 * @return uint8_t 1 if the cursor set properly, 0 otherwise
 ******************************************************************************/
 extern uint8_t 
-LcdDisplay_SetCursor(LcdDisplay_t Display, uint8_t Row, uint8_t Col)
+LcdDisplay_SetCursor(LcdDisplay_t Display, uint8_t Row, uint8_t Col,
+ LcdDisplaySeq_t* const Seq)
 {
   if(!(Display < LCD_DISPLAY_MAX &&
        Row < gConfig[Display].Height &&
@@ -386,76 +3022,318 @@ LcdDisplay_SetCursor(LcdDisplay_t Display, uint8_t Row, uint8_t Col)
       return 0;
     }
   
-  uint8_t NewAddress;
+  uint8_t Location;
 
-  switch(Row)
-  {
-    case 0:
-    NewAddress = LCD_DISPLAY_DDRAM_LINE_0;
-    break;
+  if(gFrame[Display].Staging == 1 || gFrame[Display].Committed == 1)
+    {
+      gFrame[Display].Row = Row;
+      gFrame[Display].Col = Col;
+      LcdDisplay_Ticket(Display, LCD_LANE_FRAME, Seq);
+      return 1;
+    }
+
+  Location = LcdDisplay_GetLocation(Display, Row, Col);
+  gCtrlSel[Display] = (Location & LCD_DISPLAY_LOC_CTRL) != 0;
+  gCursorRow[Display] = Row;
+  gCursorCol[Display] = Col;
+  return LcdDisplay_SetCommand(Display,
+   (Location & LCD_DISPLAY_LOC_ADDRESS) | LCD_DISPLAY_DDRAM_MASK, Seq);
+}
+
+/******************************************************************************
+* Function : LcdDisplay_GetLocation()
+*//**
+* \b Description: Utility function to get the controller and the DDRAM 
+* address of a position in the display from the table built by 
+* LcdDisplay_Init<br/>
+* \b PRE-CONDITION: Row and Col are inside the display <br/>
+* @param Display The id of the display.
+* @param Row The row in the display. It starts from zero.
+* @param Col The column in the display. It starts from zero.
+* @return uint8_t the location: LCD_DISPLAY_LOC_CTRL set for the second 
+* controller and the DDRAM address (without the DDRAM mask)
+******************************************************************************/
+static uint8_t
+LcdDisplay_GetLocation(LcdDisplay_t Display, uint8_t Row, uint8_t Col)
+{
+  return gLocation[Display][gRowStart[Display][Row] + Col];
+}
 
-    case 1:
-    NewAddress = LCD_DISPLAY_DDRAM_LINE_1;
-    break;
+/******************************************************************************
+* Function : LcdDisplay_GetCursorCommand()
+*//**
+* \b Description: Utility function to get the command that moves the 
+* address counter to the cursor of the buffered writes. Past the end of the
+* row, the address follows the last character.<br/>
+* \b PRE-CONDITION: the cursor is inside the display <br/>
+* @param Display The id of the display.
+* @return uint8_t the set DDRAM address command
+******************************************************************************/
+static uint8_t
+LcdDisplay_GetCursorCommand(LcdDisplay_t Display)
+{
+  const uint8_t Width = gConfig[Display].Width;
+  uint8_t Address;
 
-    case 2:
-    NewAddress = LCD_DISPLAY_DDRAM_LINE_0 + gConfig[Display].Width;
-    break;
+  if(gCursorCol[Display] < Width)
+    {
+      Address = LcdDisplay_GetLocation(Display, gCursorRow[Display],
+       gCursorCol[Display]) & LCD_DISPLAY_LOC_ADDRESS;
+    }
+  else
+    {
+      Address = (LcdDisplay_GetLocation(Display, gCursorRow[Display],
+       Width - 1) & LCD_DISPLAY_LOC_ADDRESS) + 1;
+    }
 
-    case 3:
-    NewAddress = LCD_DISPLAY_DDRAM_LINE_1 + gConfig[Display].Width;
-    break;
+  return Address | LCD_DISPLAY_DDRAM_MASK;
+}
 
-    default:
-    //DO NOTHING
-    break;
-  }
+/******************************************************************************
+* Function : LcdDisplay_BuildLayout()
+*//**
+* \b Description: Utility function to build the location table of a display
+* from its geometry. The geometry is looked up from the size of the display
+* if the configuration doesn't give one. A location table given by the 
+* configuration (e.g. the one lcd_display.hpp computes at compile time) is
+* copied instead.<br/>
+* \b PRE-CONDITION: gConfig is assigned <br/>
+* @param Display The id of the display.
+* @return uint8_t the number of controllers of the display, 0 if the 
+* geometry is unknown or doesn't fit
+******************************************************************************/
+static uint8_t
+LcdDisplay_BuildLayout(LcdDisplay_t Display)
+{
+  const LcdDisplayConfig_t* const Config = &gConfig[Display];
+  const LcdGeometry_t* Geometry = Config->Geometry;
+  uint8_t CtrlCount = 1;
+  uint8_t Cell = 0;
+  uint8_t Row;
+  uint8_t Col;
+  uint8_t Location;
 
-  NewAddress = NewAddress + Col;
-  NewAddress = NewAddress | LCD_DISPLAY_DDRAM_MASK;
-  LcdDisplay_SetCommand(Display, NewAddress); 
+  //keeps the buffered writes safe if the geometry is invalid
+  gRun[Display] = 1;
 
-  return 1;
+  if(Geometry == 0x00)
+    {
+      Geometry = LcdGeometry_Find(Config->Width, Config->Height);
+    }
+
+  if(!(Geometry != 0x00 &&
+       Geometry->Width == Config->Width &&
+       Geometry->Height == Config->Height &&
+       Geometry->Run != 0 &&
+       Geometry->Width % Geometry->Run == 0 &&
+       Geometry->Height * (Geometry->Width / Geometry->Run) <=
+       LCD_GEOMETRY_RUN_MAX &&
+       Geometry->Width * Geometry->Height <= LCD_DISPLAY_MAX_CELLS))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  gRun[Display] = Geometry->Run;
+
+  for(Row = 0; Row < Geometry->Height; Row++)
+    {
+      gRowStart[Display][Row] = Cell;
+
+      for(Col = 0; Col < Geometry->Width; Col++)
+        {
+          if(Config->Locations != 0x00)
+            {
+              Location = Config->Locations[Cell];
+            }
+          else
+            {
+              Location = Geometry->Start[Row * (Geometry->Width /
+               Geometry->Run) + Col / Geometry->Run] + Col % Geometry->Run;
+            }
+
+          gLocation[Display][Cell] = Location;
+
+          if(Location & LCD_GEOMETRY_CTRL2)
+            {
+              CtrlCount = 2;
+            }
+
+          Cell++;
+        }
+    }
+
+  return CtrlCount;
 }
 
 /******************************************************************************
 * Function : LcdDisplay_CreateChar()
 *//**
 * \b Description: function to create a custom character. This character
-* will be stored in CGRAM (character generator RAM). There's just a capcity of
-* 8 chararcters <br/>
+* will be stored in CGRAM (character generator RAM) of every controller of
+* the display. There's just a capcity of 8 chararcters, the last 
+* LCD_DISPLAY_GLYPH_SLOTS of them are shared with LcdDisplay_SetUtf8 <br/>
 * \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
 * @param Display The id of the display.
 * @param CharIndex The character index from 0 to 7.
 * @param Data A pointer to an array of bytes representing the character bitmap
 * 7 rows x 8 bits (the last row is reserved for the cursor). Just the first
 * 5 bits out of the 8 is used.
-* @return void
+* @param Seq A pointer to store the sequence number of the write (see
+* LcdDisplay_IsComplete), 0x00 if it isn't needed. It's left as it is if 
+* the character isn't enqueued.
+* @return uint8_t 1 if the character is enqueued, 0 if the buffer of a 
+* controller can't take all of it (nothing is enqueued then)
 ******************************************************************************/
-extern void 
+extern uint8_t 
 LcdDisplay_CreateChar(const LcdDisplay_t Display,
                       const uint8_t CharIndex,
-                      const uint8_t* const Data)
+                      const uint8_t* const Data,
+                      LcdDisplaySeq_t* const Seq)
 {
   if(!(Display < LCD_DISPLAY_MAX &&
   CharIndex < 8 &&
   Data != 0x00))
   {
     //TODO: handle this error
-    return;
+    return 0;
   }
 
   uint8_t Row;
+  uint8_t CtrlId;
   uint8_t CGRAMAddress;
 
-  for(Row = 0; Row < 7; Row++)
+  //an address command (2 bytes) and a row with its escape per row, on 
+  //every controller, or a controller would show a half made character
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      if(CircBuff_GetFree(&gCtrl[Display][CtrlId].Buff[LCD_LANE_NORMAL]) <
+         2 * 7 + 7 + LcdDisplay_CountEscapes(Data, 7))
+        {
+          return 0;
+        }
+    }
+
+  //a character replaced by the application no longer holds its glyph
+  if(CharIndex >= LCD_DISPLAY_GLYPH_FIRST)
+    {
+      gGlyphCode[Display][CharIndex - LCD_DISPLAY_GLYPH_FIRST] = 0;
+    }
+
+  //nor its animation
+  (void)LcdDisplay_Animate(Display, CharIndex, 0x00, 0, 0);
+
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      for(Row = 0; Row < 7; Row++)
+        {
+          CGRAMAddress = (uint8_t)(CharIndex << 3);
+          CGRAMAddress = CGRAMAddress + Row;
+          CGRAMAddress |= LCD_DISPLAY_CGRAM_MASK;
+
+          //the bitmap bypasses the frames, it's not a character to show
+          (void)LcdDisplay_PushCommand(Display, CtrlId, LCD_LANE_NORMAL,
+           CGRAMAddress);
+          (void)LcdDisplay_PushData(Display, CtrlId, LCD_LANE_NORMAL,
+           &Data[Row], 1);
+        }
+    }
+
+  LcdDisplay_Ticket(Display, LCD_LANE_NORMAL, Seq);
+
+#if LCD_DISPLAY_LATENCY == 1
+  LcdDisplay_Stamp(Display);
+#endif
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplay_Animate()
+*//**
+* \b Description: function to animate a custom character, e.g. a spinner or
+* a progress icon. The character shows the frames in turn, each one for 
+* Period updates. LcdDisplay_Update uploads a new frame before the normal 
+* buffer, and only the rows that differ from the previous frame. The 
+* animation is stopped by a FrameCount of 0 or by LcdDisplay_CreateChar on 
+* the same character; the last frame stays.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Display The id of the display.
+* @param CharIndex The character index from 0 to 7.
+* @param Frames A pointer to FrameCount bitmaps of LCD_DISPLAY_CGRAM_ROWS 
+* rows one after the other. It must stay valid while the character is 
+* animated.
+* @param FrameCount The number of frames, 0 to stop the animation.
+* @param Period The updates per frame. It should leave room for the normal 
+* buffer between two uploads (a changed row takes up to 2 bytes).
+* @return uint8_t 1 if the animation is started or stopped, 0 otherwise
+*
+* \b Example:
+* @code
+* static const uint8_t Spinner[4][LCD_DISPLAY_CGRAM_ROWS] = {...};
+*
+* //a frame every 10 updates (100 ms with a 10 ms LcdDisplay_Update task)
+* (void)LcdDisplay_Animate(LCD_DISPLAY_0, 0, Spinner[0], 4, 10);
+* (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"\0 Busy", 6, 0x00);
+* @endcode
+******************************************************************************/
+extern uint8_t
+LcdDisplay_Animate(const LcdDisplay_t Display,
+                   const uint8_t CharIndex,
+                   const uint8_t* const Frames,
+                   const uint8_t FrameCount,
+                   const uint16_t Period)
+{
+  if(!(Display < LCD_DISPLAY_MAX &&
+       CharIndex < LCD_DISPLAY_CGRAM_CHARS &&
+       (FrameCount == 0 || (Frames != 0x00 && Period != 0))))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  LcdAnim_t* Anim = &gAnim[Display][CharIndex];
+  uint8_t CtrlId;
+
+  if(FrameCount == 0)
+    {
+      if(Anim->Frames != 0x00)
+        {
+          Anim->Frames = 0x00;
+          gAnimCount[Display]--;
+          gAnimations--;
+        }
+
+      return 1;
+    }
+
+  if(Anim->Frames == 0x00)
+    {
+      gAnimCount[Display]++;
+      gAnimations++;
+    }
+
+  Anim->Frames = Frames;
+  Anim->Count = FrameCount;
+  Anim->Frame = 0;
+  Anim->Period = Period;
+  Anim->Ticks = Period;
+
+  if(CharIndex >= LCD_DISPLAY_GLYPH_FIRST)
     {
-      CGRAMAddress = (uint8_t)(CharIndex << 3);
-      CGRAMAddress = CGRAMAddress + Row;
-      CGRAMAddress |= LCD_DISPLAY_CGRAM_MASK;
+      gGlyphCode[Display][CharIndex - LCD_DISPLAY_GLYPH_FIRST] = 0;
+    }
 
-      LcdDisplay_SetCommand(Display, CGRAMAddress);
-      LcdDisplay_SetData(Display, &Data[Row], 1);
+  for(CtrlId = 0; CtrlId < gCtrlCount[Display]; CtrlId++)
+    {
+      //the CGRAM isn't known before the first upload, so every row of the 
+      //first frame is sent
+      gCtrl[Display][CtrlId].Stale[CharIndex] = 0xFF;
+      gCtrl[Display][CtrlId].Glyphs |= (uint8_t)(1 << CharIndex);
     }
+
+  gAnyWork = 1;
+
+  return 1;
 }
 /*****************************End of File ************************************/
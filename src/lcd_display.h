@@ -23,6 +23,60 @@
 #define LCD_DISPLAY_CGRAM_CHAR_5 0x05 /**< Character 5 of CGRAM code */ 
 #define LCD_DISPLAY_CGRAM_CHAR_6 0x06 /**< Character 6 of CGRAM code */ 
 #define LCD_DISPLAY_CGRAM_CHAR_7 0x07 /**< Character 7 of CGRAM code */ 
+
+#define LCD_DISPLAY_CGRAM_ROWS 8 /**< the rows of an animation frame */
+#define LCD_DISPLAY_CGRAM_BYTES 0x40 /**< the CGRAM bytes of a controller */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief a sequence number identifying everything enqueued to a display up 
+ * to a point, given by the Seq parameter of the writes (or 
+ * LcdDisplay_GetSeq). It holds a position per controller.
+ */
+typedef uint64_t LcdDisplaySeq_t;
+
+/**
+ * @brief a callback invoked by LcdDisplay_Update when a sequence number is
+ * complete (see LcdDisplay_OnComplete)
+ */
+typedef void (*LcdDisplayCallback_t)(LcdDisplay_t Display, LcdDisplaySeq_t Seq);
+
+/**
+ * @brief what a display shows (see LcdDisplay_Snapshot)
+ */
+typedef struct
+{
+  uint32_t Changes; /**< the change counter of the content (see 
+                         LcdDisplay_GetChanges) */
+  uint8_t Width; /**< the characters per row */
+  uint8_t Height; /**< the rows */
+  uint8_t Text[LCD_DISPLAY_MAX_CELLS]; /**< the characters, row by row */
+  uint8_t Cgram[LCD_DISPLAY_CTRL_MAX][LCD_DISPLAY_CGRAM_BYTES]; /**< the 
+                         CGRAM of each controller */
+} LcdDisplaySnapshot_t;
+
+#if LCD_DISPLAY_LATENCY == 1
+/**
+ * @brief the tick source of the latency measurement (see 
+ * LcdDisplay_SetTickSource). It's free-running and wraps around.
+ */
+typedef uint32_t (*LcdDisplayTicks_t)(void);
+
+/**
+ * @brief the latency histogram of a display (see LcdDisplay_GetLatency)
+ */
+typedef struct
+{
+  uint32_t Buckets[LCD_DISPLAY_LATENCY_BUCKETS]; /**< bucket 0 counts the 
+                         latencies of 0 ticks and bucket i the ones from 
+                         2^(i-1) to 2^i - 1 (the last one also counts the 
+                         longer ones) */
+  uint32_t Count; /**< the measured writes */
+  uint32_t Max; /**< the longest latency in ticks */
+  uint32_t Dropped; /**< the writes not measured (no free stamp) */
+} LcdDisplayLatency_t;
+#endif
 /******************************************************************************
  * Function prototypes
  ******************************************************************************/
@@ -31,18 +85,75 @@ extern "C"{
 #endif
 
 extern void LcdDisplay_Init(const LcdDisplayConfig_t * const Config);
-extern void LcdDisplay_Update(void);
-extern void LcdDisplay_Clear(LcdDisplay_t Display);
+extern uint32_t LcdDisplay_Update(void);
+extern uint8_t LcdDisplay_HasWork(void);
+extern uint16_t LcdDisplay_GetPending(const LcdDisplay_t Display);
+extern uint8_t LcdDisplay_GetSize(const LcdDisplay_t Display,
+                                  uint8_t* const Width,
+                                  uint8_t* const Height);
+extern uint8_t LcdDisplay_Clear(LcdDisplay_t Display,
+                                LcdDisplaySeq_t* const Seq);
 extern uint8_t LcdDisplay_SetData(const LcdDisplay_t Display,
                                   const uint8_t* const Data,
-                                  const uint8_t DataSize);
+                                  const uint8_t DataSize,
+                                  LcdDisplaySeq_t* const Seq);
+extern uint8_t LcdDisplay_SetDataAt(const LcdDisplay_t Display,
+                                    const uint8_t Row,
+                                    const uint8_t Col,
+                                    const uint8_t* const Data,
+                                    const uint8_t DataSize,
+                                    LcdDisplaySeq_t* const Seq);
+extern uint8_t LcdDisplay_SetUtf8(const LcdDisplay_t Display,
+                                  const uint8_t* const Text,
+                                  const uint8_t TextSize,
+                                  LcdDisplaySeq_t* const Seq);
 extern uint8_t LcdDisplay_SetCursor(LcdDisplay_t Display,
                                     uint8_t Row, 
-                                    uint8_t Col);
+                                    uint8_t Col,
+                                    LcdDisplaySeq_t* const Seq);
+extern uint8_t LcdDisplay_SetUrgent(const LcdDisplay_t Display,
+                                    const uint8_t Row,
+                                    const uint8_t Col,
+                                    const uint8_t* const Data,
+                                    const uint8_t DataSize,
+                                    LcdDisplaySeq_t* const Seq);
+extern void LcdDisplay_BeginFrame(const LcdDisplay_t Display);
+extern void LcdDisplay_EndFrame(const LcdDisplay_t Display,
+                                LcdDisplaySeq_t* const Seq);
+/**
+ * @brief once a frame is committed, the display stays on frames until this
+ * call
+ */
+extern uint8_t LcdDisplay_EndFrames(const LcdDisplay_t Display,
+                                    LcdDisplaySeq_t* const Seq);
+
+extern uint32_t LcdDisplay_GetChanges(const LcdDisplay_t Display);
+extern uint8_t LcdDisplay_Snapshot(const LcdDisplay_t Display,
+                                   LcdDisplaySnapshot_t* const Snapshot);
+
+#if LCD_DISPLAY_LATENCY == 1
+extern void LcdDisplay_SetTickSource(const LcdDisplayTicks_t Ticks);
+extern uint8_t LcdDisplay_GetLatency(const LcdDisplay_t Display,
+                                     LcdDisplayLatency_t* const Latency);
+extern void LcdDisplay_ResetLatency(const LcdDisplay_t Display);
+#endif
+
+extern LcdDisplaySeq_t LcdDisplay_GetSeq(const LcdDisplay_t Display);
+extern uint8_t LcdDisplay_IsComplete(const LcdDisplay_t Display,
+                                     const LcdDisplaySeq_t Seq);
+extern uint8_t LcdDisplay_OnComplete(const LcdDisplay_t Display,
+                                     const LcdDisplaySeq_t Seq,
+                                     const LcdDisplayCallback_t Callback);
 
-extern void LcdDisplay_CreateChar(const LcdDisplay_t Display,
+extern uint8_t LcdDisplay_CreateChar(const LcdDisplay_t Display,
+                                     const uint8_t CharIndex,
+                                     const uint8_t* const Data,
+                                     LcdDisplaySeq_t* const Seq);
+extern uint8_t LcdDisplay_Animate(const LcdDisplay_t Display,
                                   const uint8_t CharIndex,
-                                  const uint8_t* const Data);
+                                  const uint8_t* const Frames,
+                                  const uint8_t FrameCount,
+                                  const uint16_t Period);
 
 #ifdef __cplusplus
 } // extern "C"
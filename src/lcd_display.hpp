@@ -0,0 +1,383 @@
+/**
+ * @file lcd_display.hpp
+ * @author Mohamed Hassanin Mohamed
+ * @brief A header-only C++17 configuration layer over lcd_display.h. A panel
+ * is described as constexpr data, checked at compile time (geometry, pins,
+ * DDRAM layout) and turned into the LcdDisplayConfig_t of the C module. The
+ * port transport writes a whole byte through precomputed port states, so
+ * no pin mapping is left for the run time.
+ * @version 0.1
+ * @date 2021-04-16
+ *
+ * \b Example:
+ * @code
+ * constexpr lcd::PanelSpec Main =
+ *   {LCD_DISPLAY_0, 20, 4, PORTA_1, PORTA_0, PORTA_0,
+ *    {PORTA_2, PORTA_3, PORTA_4, PORTA_5}, LCD_ROM_A00};
+ *
+ * using MainPort = lcd::PortTransport<Main>;
+ *
+ * static const LcdDisplayConfig_t Config[LCD_DISPLAY_MAX] =
+ * {
+ *   lcd::Panel<Main>::Config(&MainPort::Transport)
+ * };
+ *
+ * MainPort::Bind(&PORTA);
+ * LcdDisplay_Init(Config);
+ * @endcode
+ */
+#ifndef LCD_DISPLAY_HPP
+#define LCD_DISPLAY_HPP
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <array>
+#include <cstdint>
+#include "lcd_display.h"
+
+namespace lcd
+{
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * A structure for a panel wired to dio channels. Width x Height must be one
+ * of the geometries of lcd_geometry.h.
+ */
+struct PanelSpec
+{
+  LcdDisplay_t Display; /**< The Display Id */
+  uint8_t Width;
+  uint8_t Height;
+  DioChannel_t Rs; /**< the channel used to choose data or instruction */
+  DioChannel_t En; /**< the channel used to start writing */
+  DioChannel_t En2; /**< the enable of the second controller (40x4 only) */
+  DioChannel_t Data[LCD_DISPLAY_BITLEN]; /**< D4..D7 */
+  LcdRom_t Rom; /**< the character ROM, A00 if it's omitted */
+};
+
+namespace detail
+{
+/**
+ * @brief the common geometries (see lcd_geometry.h)
+ */
+inline constexpr LcdGeometry_t Geometries[] =
+{
+  LCD_GEOMETRY_8X1,
+  LCD_GEOMETRY_8X2,
+  LCD_GEOMETRY_16X1,
+  LCD_GEOMETRY_16X2,
+  LCD_GEOMETRY_16X4,
+  LCD_GEOMETRY_20X2,
+  LCD_GEOMETRY_20X4,
+  LCD_GEOMETRY_24X2,
+  LCD_GEOMETRY_40X2,
+  LCD_GEOMETRY_40X4
+};
+
+/**
+ * @brief the length of a DDRAM line of a controller
+ */
+inline constexpr uint8_t LineLen = 0x28;
+
+/**
+ * @brief the index of the geometry of a panel size, -1 if it's unknown
+ */
+constexpr int FindGeometry(uint8_t Width, uint8_t Height)
+{
+  for(int i = 0; i < int(sizeof(Geometries) / sizeof(Geometries[0])); i++)
+    {
+      if(Geometries[i].Width == Width && Geometries[i].Height == Height)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/**
+ * @brief the port of a dio channel
+ */
+constexpr uint8_t PortOf(DioChannel_t Channel)
+{
+  return uint8_t(Channel / DIO_CHANNELS_PER_PORT);
+}
+
+/**
+ * @brief the bit of a dio channel in its port
+ */
+constexpr uint8_t BitOf(DioChannel_t Channel)
+{
+  return uint8_t(1u << (Channel % DIO_CHANNELS_PER_PORT));
+}
+} // namespace detail
+
+/******************************************************************************
+ * Panel
+ ******************************************************************************/
+/**
+ * The compile-time view of a panel: its geometry, the location of every
+ * cell (handed to the C module, so LcdDisplay_Init doesn't build it) and
+ * the checks of the configuration.
+ */
+template <const PanelSpec& Spec>
+class Panel
+{
+  static constexpr int Found = detail::FindGeometry(Spec.Width, Spec.Height);
+  static_assert(Found >= 0, "lcd: no geometry for this panel size");
+
+  //the first geometry stands in for an unknown one after the assertion
+  static constexpr int Index = (Found < 0) ? 0 : Found;
+
+  static constexpr uint8_t CountControllers()
+  {
+    for(uint8_t Run = 0; Run < LCD_GEOMETRY_RUN_MAX; Run++)
+      {
+        if(detail::Geometries[Index].Start[Run] & LCD_GEOMETRY_CTRL2) return 2;
+      }
+
+    return 1;
+  }
+
+public:
+  /** the geometry of the panel */
+  static constexpr LcdGeometry_t Geometry = detail::Geometries[Index];
+
+  /** the number of characters */
+  static constexpr uint8_t Cells = uint8_t(Spec.Width * Spec.Height);
+
+  /** the number of controllers */
+  static constexpr uint8_t Controllers = CountControllers();
+
+  static_assert(Cells <= LCD_DISPLAY_MAX_CELLS,
+   "lcd: the panel is larger than LCD_DISPLAY_MAX_CELLS");
+  static_assert(Controllers <= LCD_DISPLAY_CTRL_MAX,
+   "lcd: the panel needs more controllers than LCD_DISPLAY_CTRL_MAX");
+  static_assert(Spec.Display < LCD_DISPLAY_MAX, "lcd: invalid display id");
+
+private:
+  static constexpr std::array<uint8_t, Cells> MakeLocations()
+  {
+    std::array<uint8_t, Cells> Locations{};
+    const uint8_t RunsPerRow = Geometry.Width / Geometry.Run;
+
+    for(uint8_t Row = 0; Row < Geometry.Height; Row++)
+      {
+        for(uint8_t Col = 0; Col < Geometry.Width; Col++)
+          {
+            Locations[Row * Geometry.Width + Col] = uint8_t(
+             Geometry.Start[Row * RunsPerRow + Col / Geometry.Run] +
+             Col % Geometry.Run);
+          }
+      }
+
+    return Locations;
+  }
+
+  static constexpr bool IsLayoutValid()
+  {
+    constexpr std::array<uint8_t, Cells> Locations = MakeLocations();
+
+    //already reported
+    if(Found < 0) return true;
+
+    for(uint8_t i = 0; i < Cells; i++)
+      {
+        //inside a DDRAM line
+        if((Locations[i] & 0x3F) >= detail::LineLen) return false;
+
+        for(uint8_t j = uint8_t(i + 1); j < Cells; j++)
+          {
+            if(Locations[i] == Locations[j]) return false;
+          }
+      }
+
+    return true;
+  }
+
+  static constexpr bool ArePinsValid()
+  {
+    const DioChannel_t Pins[] =
+    {
+      Spec.Rs, Spec.En, Spec.Data[0], Spec.Data[1], Spec.Data[2],
+      Spec.Data[3], Spec.En2
+    };
+    //the second enable is only wired on two-controller panels
+    const uint8_t Count = (Controllers == 2) ? 7 : 6;
+
+    for(uint8_t i = 0; i < Count; i++)
+      {
+        if(!(Pins[i] < DIO_CHANNEL_MAX)) return false;
+
+        for(uint8_t j = uint8_t(i + 1); j < Count; j++)
+          {
+            if(Pins[i] == Pins[j]) return false;
+          }
+      }
+
+    return true;
+  }
+
+  static_assert(IsLayoutValid(), "lcd: two cells share a DDRAM address");
+  static_assert(ArePinsValid(), "lcd: a pin is invalid or used twice");
+
+public:
+  /** the location of every cell, row by row (LCD_GEOMETRY_CTRL2 for the
+   * second controller, then the DDRAM address) */
+  static constexpr std::array<uint8_t, Cells> Locations = MakeLocations();
+
+  /**
+   * @brief the location of a cell
+   */
+  static constexpr uint8_t Location(uint8_t Row, uint8_t Col)
+  {
+    return Locations[Row * Spec.Width + Col];
+  }
+
+  /**
+   * @brief the configuration of the panel for LcdDisplay_Init
+   * @param Transport the transport, the direct GPIO one by default.
+   * @param BusAddress the i2c address or spi channel if any.
+   */
+  static constexpr LcdDisplayConfig_t
+  Config(const LcdTransport_t* Transport = &LcdTransport_Dio,
+         uint8_t BusAddress = 0)
+  {
+    return LcdDisplayConfig_t
+    {
+      Spec.Display,
+      Spec.Width,
+      Spec.Height,
+      &Geometry,
+      Spec.Rs,
+      Spec.En,
+      Spec.En2,
+      {Spec.Data[0], Spec.Data[1], Spec.Data[2], Spec.Data[3]},
+      Transport,
+      BusAddress,
+      Spec.Rom,
+      Spec.En, /* unused: no scrub */
+      0,
+      Locations.data()
+    };
+  }
+};
+
+/******************************************************************************
+ * PortTransport
+ ******************************************************************************/
+/**
+ * A transport that drives RS, EN and D4..D7 wired on one port through
+ * Dio_RegisterWrite. The port states of every nibble are computed at
+ * compile time; a byte costs one register read and six register writes.
+ * Bind must be called with the port register before LcdDisplay_Init.
+ */
+template <const PanelSpec& Spec>
+class PortTransport
+{
+  using PanelType = Panel<Spec>;
+
+  static constexpr bool IsOnePort()
+  {
+    const uint8_t Port = detail::PortOf(Spec.Rs);
+
+    for(uint8_t i = 0; i < LCD_DISPLAY_BITLEN; i++)
+      {
+        if(detail::PortOf(Spec.Data[i]) != Port) return false;
+      }
+
+    return detail::PortOf(Spec.En) == Port &&
+     (PanelType::Controllers == 1 || detail::PortOf(Spec.En2) == Port);
+  }
+
+  static_assert(IsOnePort(),
+   "lcd: the port transport needs RS, EN and D4..D7 on one port");
+
+  static constexpr std::array<uint8_t, 16> MakeNibble()
+  {
+    std::array<uint8_t, 16> Nibble{};
+
+    for(uint8_t Value = 0; Value < 16; Value++)
+      {
+        for(uint8_t Bit = 0; Bit < LCD_DISPLAY_BITLEN; Bit++)
+          {
+            if(Value & (1u << Bit))
+              {
+                Nibble[Value] |= detail::BitOf(Spec.Data[Bit]);
+              }
+          }
+      }
+
+    return Nibble;
+  }
+
+public:
+  /** the port state of each nibble value */
+  static constexpr std::array<uint8_t, 16> Nibble = MakeNibble();
+
+  /** the RS bit of commands (index 0) and chars (index 1) */
+  static constexpr uint8_t Rs[2] = {0, detail::BitOf(Spec.Rs)};
+
+  /** the EN bit of the first and the second controller */
+  static constexpr uint8_t En[2] =
+  {
+    detail::BitOf(Spec.En),
+    (PanelType::Controllers == 2) ? detail::BitOf(Spec.En2) : uint8_t(0)
+  };
+
+  /** the bits of the port owned by the display */
+  static constexpr uint8_t Mask = uint8_t(Nibble[0x0F] | Rs[1] | En[0] | En[1]);
+
+  /** the transport for LcdDisplayConfig_t */
+  static inline const LcdTransport_t Transport =
+  {
+    nullptr,
+    &PortTransport::Write,
+    nullptr,
+    1,
+    nullptr /* write only */
+  };
+
+  /**
+   * @brief set the port register of the display
+   */
+  static void Bind(volatile uint8_t* const Register)
+  {
+    Port = Register;
+  }
+
+private:
+  static inline volatile uint8_t* Port = nullptr;
+
+  static void Latch(uint8_t State, uint8_t Enable)
+  {
+    //the data and RS must be stable before EN rises
+    Dio_RegisterWrite(Port, State);
+    Dio_RegisterWrite(Port, uint8_t(State | Enable));
+    Dio_RegisterWrite(Port, State);
+  }
+
+  static void Write(const LcdDisplayConfig_t* const Config, uint8_t Ctrl,
+                    uint8_t Data, uint8_t IsData)
+  {
+    (void)Config;
+
+    if(Port == nullptr)
+      {
+        //TODO: handle this error
+        return;
+      }
+
+    //keep the pins of the port that aren't used by the display
+    const uint8_t Base = uint8_t((Dio_RegisterRead(Port) & ~Mask) |
+     Rs[IsData & 0x01]);
+
+    Latch(uint8_t(Base | Nibble[Data >> 4]), En[Ctrl & 0x01]);
+    Latch(uint8_t(Base | Nibble[Data & 0x0F]), En[Ctrl & 0x01]);
+  }
+};
+} // namespace lcd
+
+#endif /* end LCD_DISPLAY_HPP */
+/*****************************End of File ************************************/
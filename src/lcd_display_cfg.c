@@ -20,7 +20,9 @@ static const LcdDisplayConfig_t LcdDisplayConfig[LCD_DISPLAY_MAX] = {
     .Display = LCD_DISPLAY_0,
     .Width = 20,
     .Height = 2,
+    .Geometry = &LcdGeometry_20x2,
     .En = PORTA_0,
+    .En2 = PORTA_0, /* unused: one controller */
     .Rs = PORTA_1,
     .Data =
     {
@@ -28,7 +30,13 @@ static const LcdDisplayConfig_t LcdDisplayConfig[LCD_DISPLAY_MAX] = {
       PORTA_3,
       PORTA_4,
       PORTA_5
-    }
+    },
+    .Transport = &LcdTransport_Dio,
+    .BusAddress = 0,
+    .Rom = LCD_ROM_A00,
+    .Rw = PORTA_0, /* unused: no scrub */
+    .ScrubBudget = 0,
+    .Locations = 0x00 /* built from the geometry */
   }
 };
 
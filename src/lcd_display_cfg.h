@@ -23,10 +23,156 @@
  */
 #define LCD_DISPLAY_BUFF_SIZE 200
 
+//TODO: change as required
+/**
+ * @brief the buffer size of the high-priority (urgent) lane of each display.
+ * It should fit the longest alarm message plus its cursor command.
+ */
+#define LCD_DISPLAY_URGENT_BUFF_SIZE 48
+
+//TODO: change as required
+/**
+ * @brief the maximum number of characters (Width x Height) of a display. It's
+ * the size of the frame buffers used by LcdDisplay_BeginFrame/EndFrame.
+ * A build can set it (e.g. the host build of the 40x4 test).
+ */
+#ifndef LCD_DISPLAY_MAX_CELLS
+#define LCD_DISPLAY_MAX_CELLS 80
+#endif
+
+//TODO: change as required
+/**
+ * @brief the maximum number of HD44780 controllers of a display. A 40x4 
+ * display has two controllers (160 cells), so it needs 2 here and 160 
+ * in LCD_DISPLAY_MAX_CELLS. 1 saves the buffers of the second controller.
+ * The controllers of a display come from its geometry (lcd_geometry.h).
+ */
+#ifndef LCD_DISPLAY_CTRL_MAX
+#define LCD_DISPLAY_CTRL_MAX 1
+#endif
+
+//TODO: change as required
+/**
+ * @brief the maximum number of pending completion callbacks of a display
+ */
+#define LCD_DISPLAY_FENCE_MAX 4
+
+//TODO: change as required
+/**
+ * @brief the PCF8574 I2C backpack wiring: the bits of the expander port 
+ * driving RS, R/W, EN and the backlight and the position of D4..D7.
+ * The enable line of the second controller of a 40x4 display takes the R/W
+ * bit (R/W is then tied low).
+ */
+#define LCD_PCF8574_RS 0x01
+#define LCD_PCF8574_RW 0x02
+#define LCD_PCF8574_EN 0x04
+#define LCD_PCF8574_EN2 0x02
+#define LCD_PCF8574_BL 0x08
+#define LCD_PCF8574_DATA_SHIFT 4
+
+//TODO: change as required
+/**
+ * @brief the maximum number of bytes sent to a PCF8574 backpack in one I2C
+ * transaction (one update). It must not exceed 42.
+ */
+#define LCD_PCF8574_BURST 8
+
+//TODO: change as required
+/**
+ * @brief the 74HC595 shift register wiring: the outputs driving RS, EN, the
+ * enable of the second controller of a 40x4 display and D4..D7.
+ */
+#define LCD_HC595_RS 0x01
+#define LCD_HC595_EN 0x02
+#define LCD_HC595_EN2 0x04
+#define LCD_HC595_D4 0x10
+#define LCD_HC595_D5 0x20
+#define LCD_HC595_D6 0x40
+#define LCD_HC595_D7 0x80
+
+//TODO: change as required
+/**
+ * @brief the maximum number of bytes shifted out to a 74HC595 in one spi 
+ * burst (one update). The HD44780 needs about 37 us to execute a byte, so 
+ * one byte per update is safe whatever the spi clock if the update period 
+ * is longer than that. In a longer burst, the bytes are spaced by 
+ * LCD_HC595_GAP_FRAMES idle latch frames of 8 spi clocks each: at least 
+ * 37 us x the spi clock / 8, e.g. 5 at 1 MHz or 37 at 8 MHz.
+ * LCD_HC595_BURST x (6 + LCD_HC595_GAP_FRAMES) must not exceed 255.
+ */
+#define LCD_HC595_BURST 1
+#define LCD_HC595_GAP_FRAMES 5
+
+//TODO: change as required
+/**
+ * @brief the number of records of the multi-threaded front end queue. It 
+ * must be a power of 2.
+ */
+#define LCD_DISPLAY_MT_QUEUE_SIZE 64
+
+//TODO: change as required
+/**
+ * @brief the maximum number of characters of a multi-threaded front end 
+ * record
+ */
+#define LCD_DISPLAY_MT_RECORD_SIZE 40
+
+//TODO: change as required
+/**
+ * @brief the maximum number of CGRAM glyphs registered by 
+ * LcdCharset_AddGlyph for the code points missing from the character ROM
+ */
+#define LCD_CHARSET_GLYPH_MAX 8
+
+//TODO: change as required
+/**
+ * @brief the number of CGRAM characters (the last ones) that 
+ * LcdDisplay_SetUtf8 uploads the missing glyphs into. LcdDisplay_CreateChar
+ * should only use the ones below them.
+ */
+#define LCD_DISPLAY_GLYPH_SLOTS 4
+
+//TODO: change as required
+/**
+ * @brief the number of ROM codes that LcdDisplay_SetUtf8 maps before writing
+ * them (stack usage: twice this size)
+ */
+#define LCD_DISPLAY_UTF8_CHUNK 16
+
+//TODO: change as required
+/**
+ * @brief the updates the busy flag of a controller may stay set before the
+ * DDRAM scrub takes it for a mode loss and initializes the controller again
+ */
+#define LCD_DISPLAY_SCRUB_STALL 8
+
+//TODO: change as required
+/**
+ * @brief 1 to measure the latency of the writes from LcdDisplay_SetData (or
+ * a command) to the display (see LcdDisplay_GetLatency), 0 to compile it out.
+ * A build can set it (e.g. the host build of the tests measures).
+ */
+#ifndef LCD_DISPLAY_LATENCY
+#define LCD_DISPLAY_LATENCY 0
+#endif
+
+//TODO: change as required
+/**
+ * @brief the log2 buckets of a latency histogram (up to 32) and the writes 
+ * of a display that can be measured at the same time (the others are 
+ * dropped)
+ */
+#define LCD_DISPLAY_LATENCY_BUCKETS 16
+#define LCD_DISPLAY_LATENCY_STAMPS 8
+
 /******************************************************************************
  * Includes
  ******************************************************************************/
 #include "../dio/dio.h"
+#include "lcd_transport.h"
+#include "lcd_geometry.h"
+#include "lcd_charset.h"
 /******************************************************************************
  * Typedefs
  ******************************************************************************/
@@ -43,14 +189,25 @@ typedef enum
 /**
 * A structure for the display configuration
 */
-typedef struct
+typedef struct LcdDisplayConfig
 {
   LcdDisplay_t Display; /**< The Display Id*/
   uint8_t Width;
   uint8_t Height;
+  const LcdGeometry_t* Geometry; /**< the DDRAM layout, 0 to look it up */
   DioChannel_t Rs; /**< the channel used to choose data or instruction */
   DioChannel_t En; /**< the channel used to start writing */
+  DioChannel_t En2; /**< the enable of the second controller (40x4 only) */
   DioChannel_t Data[LCD_DISPLAY_BITLEN]; /**< the data channels */
+  const LcdTransport_t* Transport; /**< the transport, 0 for direct GPIO */
+  uint8_t BusAddress; /**< the i2c address or spi channel if any */
+  LcdRom_t Rom; /**< the character ROM of the controllers */
+  DioChannel_t Rw; /**< the R/W channel, only used to read back */
+  uint8_t ScrubBudget; /**< the DDRAM scrub steps per update, 0 for none */
+  const uint8_t* Locations; /**< the location of every cell row by row 
+                  (LCD_GEOMETRY_CTRL2 for the second controller, then the 
+                  DDRAM address) in the runs of the geometry, 0 to build it 
+                  from the geometry */
 } LcdDisplayConfig_t;
 
 /******************************************************************************
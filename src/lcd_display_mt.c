@@ -0,0 +1,577 @@
+/**
+ * @file lcd_display_mt.c
+ * @author Mohamed Hassanin
+ * @brief Multi-threaded host front end of the LCD display module. Writer
+ * threads enqueue records into a lock-free multi-producer/single-consumer
+ * queue and a flusher thread applies them and calls LcdDisplay_Update.
+ * It needs C11 atomics and POSIX threads (embedded Linux or a host).
+ * @version 0.1
+ * @date 2021-04-15
+ */
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 200112L
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdatomic.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <time.h>
+#include "lcd_display_mt.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LCD_MT_MASK (LCD_DISPLAY_MT_QUEUE_SIZE - 1U) /**< the index mask */
+
+/**
+ * @brief the characters from it are escaped (2 bytes) in a display buffer
+ * and an urgent message takes 2 more bytes for its cursor command
+ */
+#define LCD_MT_ESCAPED 0x80
+#define LCD_MT_URGENT_CURSOR 2
+
+#if (LCD_DISPLAY_MT_QUEUE_SIZE & LCD_MT_MASK) != 0
+#error "LCD_DISPLAY_MT_QUEUE_SIZE must be a power of 2"
+#endif
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief enumeration for the record types
+ */
+typedef enum
+{
+  LCD_MT_WRITE, /**< LcdDisplay_SetCursor then LcdDisplay_SetData */
+  LCD_MT_URGENT, /**< LcdDisplay_SetUrgent */
+  LCD_MT_CLEAR, /**< LcdDisplay_Clear */
+  LCD_MT_MAX
+} LcdMtType_t;
+
+/**
+ * @brief a record of the queue
+ */
+typedef struct
+{
+  LcdDisplay_t Display; /**< the display */
+  LcdMtType_t Type; /**< the record type */
+  uint8_t Row; /**< the row of the text */
+  uint8_t Col; /**< the column of the text */
+  uint8_t Size; /**< the number of characters */
+  uint8_t Data[LCD_DISPLAY_MT_RECORD_SIZE]; /**< the characters */
+} LcdMtRecord_t;
+
+/**
+ * @brief a cell of the queue. Seq equals the position of the cell when it's
+ * free for that position and the position + 1 when it holds its record.
+ */
+typedef struct
+{
+  atomic_size_t Seq; /**< the sequence of the cell */
+  LcdMtRecord_t Record; /**< the record */
+} LcdMtCell_t;
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the cells of the queue
+ */
+static LcdMtCell_t gCells[LCD_DISPLAY_MT_QUEUE_SIZE];
+
+/**
+ * @brief the next position to enqueue at. Producers claim it with a CAS.
+ */
+static atomic_size_t gTail;
+
+/**
+ * @brief the next position to dequeue from. Only the flusher thread uses it.
+ */
+static size_t gHead;
+
+/**
+ * @brief the record being applied by the flusher thread
+ */
+static LcdMtRecord_t gPending;
+static uint8_t gHasPending; /**< 1 if gPending is valid */
+static uint8_t gCursorSet; /**< 1 if the cursor of gPending is set */
+static uint8_t gOffset; /**< the characters of gPending already set */
+
+/**
+ * @brief 1 while the flusher thread should keep running
+ */
+static atomic_int gRunning;
+
+/**
+ * @brief the statistics
+ */
+static atomic_uint_least32_t gApplied;
+static atomic_uint_least32_t gRejected;
+static atomic_uint_least32_t gDropped;
+
+/**
+ * @brief the flusher thread and its period
+ */
+static pthread_t gFlusher;
+static uint32_t gPeriodUs;
+/******************************************************************************
+ * Functions Prototypes
+ ******************************************************************************/
+static uint8_t LcdDisplayMt_Push(const LcdMtRecord_t* const Record);
+static uint8_t LcdDisplayMt_Pop(LcdMtRecord_t* const Record);
+static uint8_t LcdDisplayMt_Enqueue(LcdDisplay_t Display, LcdMtType_t Type,
+ uint8_t Row, uint8_t Col, const uint8_t* const Data, uint8_t DataSize);
+static uint8_t LcdDisplayMt_IsValid(LcdDisplay_t Display, LcdMtType_t Type,
+ uint8_t Row, uint8_t Col, const uint8_t* const Data, uint8_t DataSize);
+static uint8_t LcdDisplayMt_Apply(void);
+static void LcdDisplayMt_Drain(void);
+static void* LcdDisplayMt_Flusher(void* Arg);
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdDisplayMt_Start()
+*//**
+* \b Description: Start the flusher thread. From then on the LcdDisplay_*
+* functions must only be called by the flusher thread; writer threads use
+* the LcdDisplayMt_* functions.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param PeriodUs The period of LcdDisplay_Update in microseconds.
+* @return uint8_t 1 if the thread is started, 0 otherwise
+******************************************************************************/
+extern uint8_t
+LcdDisplayMt_Start(const uint32_t PeriodUs)
+{
+  size_t Cell;
+
+  if(atomic_load(&gRunning) == 1)
+    {
+      return 0;
+    }
+
+  for(Cell = 0; Cell < LCD_DISPLAY_MT_QUEUE_SIZE; Cell++)
+    {
+      atomic_init(&gCells[Cell].Seq, Cell);
+    }
+  atomic_init(&gTail, 0);
+  gHead = 0;
+  gHasPending = 0;
+  atomic_init(&gApplied, 0);
+  atomic_init(&gRejected, 0);
+  atomic_init(&gDropped, 0);
+  gPeriodUs = PeriodUs;
+
+  atomic_store(&gRunning, 1);
+  if(pthread_create(&gFlusher, 0x00, LcdDisplayMt_Flusher, 0x00) != 0)
+    {
+      atomic_store(&gRunning, 0);
+      return 0;
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Stop()
+*//**
+* \b Description: Stop the flusher thread once every enqueued record reached
+* the displays<br/>
+* @return void
+******************************************************************************/
+extern void
+LcdDisplayMt_Stop(void)
+{
+  if(atomic_exchange(&gRunning, 0) == 1)
+    {
+      (void)pthread_join(gFlusher, 0x00);
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Write()
+*//**
+* \b Description: Enqueue text at a position of a display. It's safe to call
+* from any thread; the cursor and the text are applied as one record so
+* writes of different threads never interleave.<br/>
+* @param Display The id of the display.
+* @param Row The row of the text. It starts from zero.
+* @param Col The column of the text. It starts from zero.
+* @param Data A pointer to the text.
+* @param DataSize The number of characters (up to LCD_DISPLAY_MT_RECORD_SIZE)
+* @return uint8_t 1 if the record is enqueued, 0 otherwise (the queue is full
+* or the position is outside the display)
+******************************************************************************/
+extern uint8_t
+LcdDisplayMt_Write(const LcdDisplay_t Display,
+                   const uint8_t Row,
+                   const uint8_t Col,
+                   const uint8_t* const Data,
+                   const uint8_t DataSize)
+{
+  return LcdDisplayMt_Enqueue(Display, LCD_MT_WRITE, Row, Col, Data, DataSize);
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_SetUrgent()
+*//**
+* \b Description: Enqueue an urgent message (see LcdDisplay_SetUrgent). It's
+* safe to call from any thread.<br/>
+* @param Display The id of the display.
+* @param Row The row of the message. It starts from zero.
+* @param Col The column of the message. It starts from zero.
+* @param Data A pointer to the message.
+* @param DataSize The number of characters (up to LCD_DISPLAY_MT_RECORD_SIZE)
+* @return uint8_t 1 if the record is enqueued, 0 otherwise (the queue is full,
+* the position is outside the display or the message is larger than the
+* urgent buffer)
+******************************************************************************/
+extern uint8_t
+LcdDisplayMt_SetUrgent(const LcdDisplay_t Display,
+                       const uint8_t Row,
+                       const uint8_t Col,
+                       const uint8_t* const Data,
+                       const uint8_t DataSize)
+{
+  return LcdDisplayMt_Enqueue(Display, LCD_MT_URGENT, Row, Col, Data, DataSize);
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Clear()
+*//**
+* \b Description: Enqueue a clear of a display. It's safe to call from any
+* thread.<br/>
+* @param Display The id of the display.
+* @return uint8_t 1 if the record is enqueued, 0 otherwise (the queue is full)
+******************************************************************************/
+extern uint8_t
+LcdDisplayMt_Clear(const LcdDisplay_t Display)
+{
+  return LcdDisplayMt_Enqueue(Display, LCD_MT_CLEAR, 0, 0, 0x00, 0);
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_GetStats()
+*//**
+* \b Description: Get the statistics of the front end<br/>
+* @param Stats a pointer to store the statistics in.
+* @return void
+******************************************************************************/
+extern void
+LcdDisplayMt_GetStats(LcdDisplayMtStats_t* const Stats)
+{
+  if(Stats == 0x00) return;
+
+  Stats->Applied = (uint32_t)atomic_load(&gApplied);
+  Stats->Rejected = (uint32_t)atomic_load(&gRejected);
+  Stats->Dropped = (uint32_t)atomic_load(&gDropped);
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Enqueue()
+*//**
+* \b Description: Utility function to build a record and push it<br/>
+* @param Display The id of the display.
+* @param Type The record type.
+* @param Row The row of the text.
+* @param Col The column of the text.
+* @param Data A pointer to the text (may be 0 if DataSize is 0).
+* @param DataSize The number of characters.
+* @return uint8_t 1 if the record is enqueued, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplayMt_Enqueue(LcdDisplay_t Display, LcdMtType_t Type, uint8_t Row,
+ uint8_t Col, const uint8_t* const Data, uint8_t DataSize)
+{
+  if(LcdDisplayMt_IsValid(Display, Type, Row, Col, Data, DataSize) == 0)
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  LcdMtRecord_t Record;
+  uint8_t i;
+
+  Record.Display = Display;
+  Record.Type = Type;
+  Record.Row = Row;
+  Record.Col = Col;
+  Record.Size = DataSize;
+  for(i = 0; i < DataSize; i++)
+    {
+      Record.Data[i] = Data[i];
+    }
+
+  if(LcdDisplayMt_Push(&Record) == 0)
+    {
+      (void)atomic_fetch_add_explicit(&gRejected, 1, memory_order_relaxed);
+      return 0;
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_IsValid()
+*//**
+* \b Description: Utility function to check that a record can be applied 
+* once the display buffers drain: its position is inside the display and 
+* an urgent message fits the urgent buffer. The records that fail it would
+* block the queue.<br/>
+* @param Display The id of the display.
+* @param Type The record type.
+* @param Row The row of the text.
+* @param Col The column of the text.
+* @param Data A pointer to the text (may be 0 if DataSize is 0).
+* @param DataSize The number of characters.
+* @return uint8_t 1 if the record is valid, 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplayMt_IsValid(LcdDisplay_t Display, LcdMtType_t Type, uint8_t Row,
+ uint8_t Col, const uint8_t* const Data, uint8_t DataSize)
+{
+  uint8_t Width;
+  uint8_t Height;
+  uint16_t Bytes = LCD_MT_URGENT_CURSOR;
+  uint8_t i;
+
+  if(!(Type < LCD_MT_MAX && DataSize <= LCD_DISPLAY_MT_RECORD_SIZE &&
+       (Data != 0x00 || DataSize == 0) &&
+       LcdDisplay_GetSize(Display, &Width, &Height) == 1))
+    {
+      return 0;
+    }
+
+  if(Type == LCD_MT_CLEAR)
+    {
+      return 1;
+    }
+
+  if(!(Row < Height && Col < Width))
+    {
+      return 0;
+    }
+
+  if(Type == LCD_MT_URGENT)
+    {
+      for(i = 0; i < DataSize; i++)
+        {
+          Bytes += (Data[i] >= LCD_MT_ESCAPED) ? 2 : 1;
+        }
+
+      //a circular buffer holds one byte less than its size
+      if(!(Bytes < LCD_DISPLAY_URGENT_BUFF_SIZE))
+        {
+          return 0;
+        }
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Push()
+*//**
+* \b Description: Utility function to push a record into the queue. A
+* producer claims a position with a CAS on the tail, fills the cell then
+* publishes it through the cell sequence. No lock is taken.<br/>
+* @param Record a pointer to the record.
+* @return uint8_t 1 if the record is pushed, 0 if the queue is full
+******************************************************************************/
+static uint8_t
+LcdDisplayMt_Push(const LcdMtRecord_t* const Record)
+{
+  size_t Pos = atomic_load_explicit(&gTail, memory_order_relaxed);
+  LcdMtCell_t* Cell;
+  size_t Seq;
+
+  for(;;)
+    {
+      Cell = &gCells[Pos & LCD_MT_MASK];
+      Seq = atomic_load_explicit(&Cell->Seq, memory_order_acquire);
+
+      if(Seq == Pos)
+        {
+          if(atomic_compare_exchange_weak_explicit(&gTail, &Pos, Pos + 1,
+              memory_order_relaxed, memory_order_relaxed))
+            {
+              break;
+            }
+        }
+      else if((ptrdiff_t)(Seq - Pos) < 0)
+        {
+          //the cell still holds the record of the previous lap
+          return 0;
+        }
+      else
+        {
+          Pos = atomic_load_explicit(&gTail, memory_order_relaxed);
+        }
+    }
+
+  Cell->Record = *Record;
+  atomic_store_explicit(&Cell->Seq, Pos + 1, memory_order_release);
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Pop()
+*//**
+* \b Description: Utility function to pop the oldest record from the queue.
+* Only the flusher thread calls it.<br/>
+* @param Record a pointer to store the record in.
+* @return uint8_t 1 if a record is popped, 0 if the queue is empty
+******************************************************************************/
+static uint8_t
+LcdDisplayMt_Pop(LcdMtRecord_t* const Record)
+{
+  LcdMtCell_t* Cell = &gCells[gHead & LCD_MT_MASK];
+  size_t Seq = atomic_load_explicit(&Cell->Seq, memory_order_acquire);
+
+  if(Seq != gHead + 1)
+    {
+      return 0;
+    }
+
+  *Record = Cell->Record;
+  atomic_store_explicit(&Cell->Seq, gHead + LCD_DISPLAY_MT_QUEUE_SIZE,
+   memory_order_release);
+  gHead++;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Apply()
+*//**
+* \b Description: Utility function to apply the pending record to the
+* display module. A record that doesn't fit the display buffer is kept and
+* continued on the next call so the records stay in order. A record that 
+* makes no progress while the display buffers are empty never will (e.g. 
+* text clipped by a frame or split over more runs than the urgent buffer 
+* holds), so it's dropped instead of blocking the queue.<br/>
+* @return uint8_t 1 if the record is done (applied or dropped), 0 otherwise
+******************************************************************************/
+static uint8_t
+LcdDisplayMt_Apply(void)
+{
+  LcdMtRecord_t* Record = &gPending;
+  const uint8_t Offset = gOffset;
+  const uint8_t CursorSet = gCursorSet;
+  uint8_t res = 1;
+
+  switch(Record->Type)
+  {
+    case LCD_MT_WRITE:
+    if(gCursorSet == 0)
+      {
+        gCursorSet = LcdDisplay_SetCursor(Record->Display, Record->Row,
+         Record->Col, 0x00);
+      }
+    if(gCursorSet == 1)
+      {
+        gOffset += LcdDisplay_SetData(Record->Display, &Record->Data[gOffset],
+         Record->Size - gOffset, 0x00);
+      }
+    res = (gCursorSet == 1 && gOffset == Record->Size);
+    break;
+
+    case LCD_MT_URGENT:
+    res = LcdDisplay_SetUrgent(Record->Display, Record->Row, Record->Col,
+     Record->Data, Record->Size, 0x00);
+    break;
+
+    case LCD_MT_CLEAR:
+    res = LcdDisplay_Clear(Record->Display, 0x00);
+    break;
+
+    default:
+    //DO NOTHING
+    break;
+  }
+
+  if(res == 1)
+    {
+      (void)atomic_fetch_add_explicit(&gApplied, 1, memory_order_relaxed);
+    }
+  else if(gOffset == Offset && gCursorSet == CursorSet &&
+          LcdDisplay_GetPending(Record->Display) == 0)
+    {
+      (void)atomic_fetch_add_explicit(&gDropped, 1, memory_order_relaxed);
+      res = 1;
+    }
+
+  return res;
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Drain()
+*//**
+* \b Description: Utility function to apply the queued records until the
+* queue is empty or a display buffer is full<br/>
+* @return void
+******************************************************************************/
+static void
+LcdDisplayMt_Drain(void)
+{
+  for(;;)
+    {
+      if(gHasPending == 0)
+        {
+          if(LcdDisplayMt_Pop(&gPending) == 0) return;
+
+          gHasPending = 1;
+          gCursorSet = 0;
+          gOffset = 0;
+        }
+
+      if(LcdDisplayMt_Apply() == 0) return;
+
+      gHasPending = 0;
+    }
+}
+
+/******************************************************************************
+* Function : LcdDisplayMt_Flusher()
+*//**
+* \b Description: The flusher thread. It drains the queue and calls
+* LcdDisplay_Update every period. When stopped, it keeps going until every
+* record reached the displays.<br/>
+* @param Arg unused.
+* @return void* 0
+******************************************************************************/
+static void*
+LcdDisplayMt_Flusher(void* Arg)
+{
+  struct timespec Period;
+  int Running;
+  uint32_t Pending;
+
+  (void)Arg;
+  Period.tv_sec = gPeriodUs / 1000000UL;
+  Period.tv_nsec = (long)(gPeriodUs % 1000000UL) * 1000L;
+
+  for(;;)
+    {
+      Running = atomic_load(&gRunning);
+
+      LcdDisplayMt_Drain();
+      Pending = LcdDisplay_Update();
+
+      //a scrubbed or animated display always has work: the writes are what
+      //matters
+      if(Running == 0 && Pending == 0 && gHasPending == 0)
+        {
+          break;
+        }
+
+      if(gPeriodUs != 0)
+        {
+          (void)nanosleep(&Period, 0x00);
+        }
+    }
+
+  return 0x00;
+}
+/*****************************End of File ************************************/
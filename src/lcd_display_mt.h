@@ -0,0 +1,58 @@
+/**
+ * @file lcd_display_mt.h
+ * @author Mohamed Hassanin Mohamed
+ * @brief Multi-threaded host front end of the LCD display module. Writer
+ * threads enqueue records into a lock-free multi-producer/single-consumer
+ * queue and a flusher thread applies them and calls LcdDisplay_Update.
+ * It needs C11 atomics and POSIX threads (embedded Linux or a host).
+ * @version 0.1
+ * @date 2021-04-15
+ */
+#ifndef LCD_DISPLAY_MT
+#define LCD_DISPLAY_MT
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "lcd_display.h"
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * A structure for the statistics of the front end
+ */
+typedef struct
+{
+  uint32_t Applied; /**< the records applied by the flusher thread */
+  uint32_t Rejected; /**< the records rejected because the queue was full */
+  uint32_t Dropped; /**< the records the display module can never accept 
+                         (e.g. an urgent message larger than its lane) */
+} LcdDisplayMtStats_t;
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern uint8_t LcdDisplayMt_Start(const uint32_t PeriodUs);
+extern void LcdDisplayMt_Stop(void);
+extern uint8_t LcdDisplayMt_Write(const LcdDisplay_t Display,
+                                  const uint8_t Row,
+                                  const uint8_t Col,
+                                  const uint8_t* const Data,
+                                  const uint8_t DataSize);
+extern uint8_t LcdDisplayMt_SetUrgent(const LcdDisplay_t Display,
+                                      const uint8_t Row,
+                                      const uint8_t Col,
+                                      const uint8_t* const Data,
+                                      const uint8_t DataSize);
+extern uint8_t LcdDisplayMt_Clear(const LcdDisplay_t Display);
+extern void LcdDisplayMt_GetStats(LcdDisplayMtStats_t* const Stats);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end LCD_DISPLAY_MT */
+/*****************************End of File ************************************/
@@ -0,0 +1,68 @@
+/**
+ * @file lcd_geometry.c
+ * @author Mohamed Hassanin
+ * @brief The geometry descriptors of the common character LCD panels.
+ * @version 0.1
+ * @date 2021-04-14
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lcd_geometry.h"
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+const LcdGeometry_t LcdGeometry_8x1 = LCD_GEOMETRY_8X1;
+const LcdGeometry_t LcdGeometry_8x2 = LCD_GEOMETRY_8X2;
+const LcdGeometry_t LcdGeometry_16x1 = LCD_GEOMETRY_16X1;
+const LcdGeometry_t LcdGeometry_16x2 = LCD_GEOMETRY_16X2;
+const LcdGeometry_t LcdGeometry_16x4 = LCD_GEOMETRY_16X4;
+const LcdGeometry_t LcdGeometry_20x2 = LCD_GEOMETRY_20X2;
+const LcdGeometry_t LcdGeometry_20x4 = LCD_GEOMETRY_20X4;
+const LcdGeometry_t LcdGeometry_24x2 = LCD_GEOMETRY_24X2;
+const LcdGeometry_t LcdGeometry_40x2 = LCD_GEOMETRY_40X2;
+const LcdGeometry_t LcdGeometry_40x4 = LCD_GEOMETRY_40X4;
+
+/**
+ * @brief the geometries looked up by LcdGeometry_Find
+ */
+static const LcdGeometry_t* const gGeometries[] =
+{
+  &LcdGeometry_8x1,
+  &LcdGeometry_8x2,
+  &LcdGeometry_16x1,
+  &LcdGeometry_16x2,
+  &LcdGeometry_16x4,
+  &LcdGeometry_20x2,
+  &LcdGeometry_20x4,
+  &LcdGeometry_24x2,
+  &LcdGeometry_40x2,
+  &LcdGeometry_40x4
+};
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdGeometry_Find()
+*//**
+* \b Description: Find the geometry of a common panel size<br/>
+* @param Width The characters per row.
+* @param Height The rows.
+* @return const LcdGeometry_t* the geometry, 0 if the size is unknown
+******************************************************************************/
+const LcdGeometry_t*
+LcdGeometry_Find(const uint8_t Width, const uint8_t Height)
+{
+  uint8_t i;
+
+  for(i = 0; i < sizeof(gGeometries) / sizeof(gGeometries[0]); i++)
+    {
+      if(gGeometries[i]->Width == Width && gGeometries[i]->Height == Height)
+        {
+          return gGeometries[i];
+        }
+    }
+
+  return 0x00;
+}
+/*****************************End of File ************************************/
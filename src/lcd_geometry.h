@@ -0,0 +1,89 @@
+/**
+ * @file lcd_geometry.h
+ * @author Mohamed Hassanin Mohamed
+ * @brief The geometry descriptors of the common character LCD panels: how
+ * the rows and columns of a panel map to the DDRAM of its controllers.
+ * @version 0.1
+ * @date 2021-04-14
+ */
+#ifndef LCD_GEOMETRY
+#define LCD_GEOMETRY
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/**
+ * @brief the maximum number of contiguous DDRAM runs of a panel
+ */
+#define LCD_GEOMETRY_RUN_MAX 4
+
+/**
+ * @brief marks a run on the second controller (40x4 panels)
+ */
+#define LCD_GEOMETRY_CTRL2 0x80
+
+/**
+ * @brief the initializers of the common geometries. They're shared by 
+ * lcd_geometry.c and the compile-time checks of lcd_display.hpp.
+ */
+#define LCD_GEOMETRY_8X1 {8, 1, 8, {0x00}}
+#define LCD_GEOMETRY_8X2 {8, 2, 8, {0x00, 0x40}}
+#define LCD_GEOMETRY_16X1 {16, 1, 8, {0x00, 0x40}}
+#define LCD_GEOMETRY_16X2 {16, 2, 16, {0x00, 0x40}}
+#define LCD_GEOMETRY_16X4 {16, 4, 16, {0x00, 0x40, 0x10, 0x50}}
+#define LCD_GEOMETRY_20X2 {20, 2, 20, {0x00, 0x40}}
+#define LCD_GEOMETRY_20X4 {20, 4, 20, {0x00, 0x40, 0x14, 0x54}}
+#define LCD_GEOMETRY_24X2 {24, 2, 24, {0x00, 0x40}}
+#define LCD_GEOMETRY_40X2 {40, 2, 40, {0x00, 0x40}}
+#define LCD_GEOMETRY_40X4 {40, 4, 40, {0x00, 0x40, \
+ LCD_GEOMETRY_CTRL2 | 0x00, LCD_GEOMETRY_CTRL2 | 0x40}}
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * A structure for a panel geometry. Every row is made of Width / Run runs
+ * of Run characters with contiguous DDRAM addresses. Most panels have one
+ * run per row; a 16x1 panel is addressed as two 8-character halves.
+ */
+typedef struct LcdGeometry
+{
+  uint8_t Width; /**< the characters per row */
+  uint8_t Height; /**< the rows */
+  uint8_t Run; /**< the characters per run (Width if a row is contiguous) */
+  uint8_t Start[LCD_GEOMETRY_RUN_MAX]; /**< the DDRAM address of each run,
+                                            row by row */
+} LcdGeometry_t;
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern const LcdGeometry_t LcdGeometry_8x1;
+extern const LcdGeometry_t LcdGeometry_8x2;
+extern const LcdGeometry_t LcdGeometry_16x1; /**< split 8 + 8 addressing */
+extern const LcdGeometry_t LcdGeometry_16x2;
+extern const LcdGeometry_t LcdGeometry_16x4;
+extern const LcdGeometry_t LcdGeometry_20x2;
+extern const LcdGeometry_t LcdGeometry_20x4;
+extern const LcdGeometry_t LcdGeometry_24x2;
+extern const LcdGeometry_t LcdGeometry_40x2;
+extern const LcdGeometry_t LcdGeometry_40x4; /**< two controllers */
+
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+const LcdGeometry_t* LcdGeometry_Find(const uint8_t Width,
+                                      const uint8_t Height);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end LCD_GEOMETRY */
+/*****************************End of File ************************************/
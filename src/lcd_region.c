@@ -0,0 +1,400 @@
+/**
+ * @file lcd_region.c
+ * @author Mohamed Hassanin
+ * @brief Text regions of the LCD displays: rectangular windows with their
+ * own cursor, line wrap or clipping and vertical scroll.
+ * @version 0.1
+ * @date 2021-04-20
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lcd_region.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LCD_REGION_BLANK ' ' /**< the character of an empty cell */
+#define LCD_REGION_NEW_LINE '\n' /**< moves the cursor to the next line */
+#define LCD_REGION_CLEAN 0xFF /**< LcdRegion_t.First of a rendered row */
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void LcdRegion_NewLine(LcdRegion_t* const Region);
+static void LcdRegion_Shift(LcdRegion_t* const Region, uint8_t Lines);
+static void LcdRegion_Mark(LcdRegion_t* const Region, uint8_t Row,
+ uint8_t Col);
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdRegion_Create()
+*//**
+* \b Description: Create a text region of a display. The text starts blank
+* and is rendered by the first write; the rest of the display isn't
+* touched.<br/>
+* \b PRE-CONDITION: LcdDisplay_Init is called properly <br/>
+* @param Region a valid pointer to the region to create.
+* @param Display The id of the display.
+* @param Row The first row of the region in the display.
+* @param Col The first column of the region in the display.
+* @param Width The columns of the region.
+* @param Height The rows of the region (up to LCD_REGION_ROWS_MAX).
+* @param Mode LCD_REGION_CLIP or a mix of LCD_REGION_WRAP and
+* LCD_REGION_SCROLL.
+* @param Text A buffer of Width * Height characters for the region text.
+* @return uint8_t 1 if the region is created, 0 if the parameters are 
+* invalid or the region doesn't lie inside the display (the region then 
+* ignores the writes)
+*
+* \b Example:
+* @code
+* uint8_t LogText[20 * 3];
+* LcdRegion_t Log;
+* if(LcdRegion_Create(&Log, LCD_DISPLAY_0, 1, 0, 20, 3,
+*     LCD_REGION_WRAP | LCD_REGION_SCROLL, LogText) == 1)
+*   {
+*     (void)LcdRegion_Write(&Log, (const uint8_t*)"boot ok\n", 8);
+*   }
+* @endcode
+******************************************************************************/
+extern uint8_t
+LcdRegion_Create(LcdRegion_t* const Region, const LcdDisplay_t Display,
+ const uint8_t Row, const uint8_t Col, const uint8_t Width,
+ const uint8_t Height, const uint8_t Mode, uint8_t* const Text)
+{
+  if(Region == 0x00)
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint8_t DisplayWidth = 0;
+  uint8_t DisplayHeight = 0;
+  uint16_t Cell;
+  uint8_t Line;
+
+  Region->Display = Display;
+  Region->Row = Row;
+  Region->Col = Col;
+  Region->Width = 0;
+  Region->Height = 0;
+  Region->Mode = Mode;
+  Region->CursorRow = 0;
+  Region->CursorCol = 0;
+  Region->Text = Text;
+
+  if(!(Text != 0x00 && Width != 0 && Height != 0 &&
+       Height <= LCD_REGION_ROWS_MAX &&
+       LcdDisplay_GetSize(Display, &DisplayWidth, &DisplayHeight) == 1 &&
+       Row < DisplayHeight && Height <= DisplayHeight - Row &&
+       Col < DisplayWidth && Width <= DisplayWidth - Col))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  Region->Width = Width;
+  Region->Height = Height;
+
+  for(Cell = 0; Cell < (uint16_t)Width * Height; Cell++)
+    {
+      Text[Cell] = LCD_REGION_BLANK;
+    }
+
+  for(Line = 0; Line < Height; Line++)
+    {
+      Region->First[Line] = 0;
+      Region->Last[Line] = Width - 1;
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdRegion_Clear()
+*//**
+* \b Description: Clear the region and move its cursor to the first char<br/>
+* \b PRE-CONDITION: the region is created by LcdRegion_Create <br/>
+* @param Region a valid pointer to the region.
+* @return void
+******************************************************************************/
+extern void
+LcdRegion_Clear(LcdRegion_t* const Region)
+{
+  if(Region == 0x00)
+    {
+      //TODO: handle this error
+      return;
+    }
+
+  Region->CursorRow = 0;
+  Region->CursorCol = 0;
+  LcdRegion_Shift(Region, Region->Height);
+  (void)LcdRegion_Flush(Region);
+}
+
+/******************************************************************************
+* Function : LcdRegion_SetCursor()
+*//**
+* \b Description: Set the position of the region cursor<br/>
+* \b PRE-CONDITION: the region is created by LcdRegion_Create <br/>
+* @param Region a valid pointer to the region.
+* @param Row The row of the cursor in the region. It starts from zero.
+* @param Col The column of the cursor in the region. It starts from zero.
+* @return uint8_t 1 if the cursor set properly, 0 otherwise
+******************************************************************************/
+extern uint8_t
+LcdRegion_SetCursor(LcdRegion_t* const Region, const uint8_t Row,
+ const uint8_t Col)
+{
+  if(!(Region != 0x00 && Row < Region->Height && Col < Region->Width))
+    {
+      return 0;
+    }
+
+  Region->CursorRow = Row;
+  Region->CursorCol = Col;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : LcdRegion_Write()
+*//**
+* \b Description: Write text at the region cursor. '\n' starts a new line.
+* A line longer than the region is wrapped (LCD_REGION_WRAP) or clipped.
+* Past the last line, the region scrolls up (LCD_REGION_SCROLL) or drops
+* the text. Only the cells that change are sent to the display; the ones
+* that don't fit in its buffer are sent by the next write or
+* LcdRegion_Flush.<br/>
+* \b PRE-CONDITION: the region is created by LcdRegion_Create <br/>
+* @param Region a valid pointer to the region.
+* @param Data A pointer to the text.
+* @param DataSize The number of characters.
+* @return uint8_t how many characters are stored in the region
+******************************************************************************/
+extern uint8_t
+LcdRegion_Write(LcdRegion_t* const Region, const uint8_t* const Data,
+ const uint8_t DataSize)
+{
+  if(!(Region != 0x00 && Data != 0x00))
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint8_t Stored = 0;
+  uint8_t i;
+
+  for(i = 0; i < DataSize; i++)
+    {
+      if(Data[i] == LCD_REGION_NEW_LINE)
+        {
+          LcdRegion_NewLine(Region);
+          continue;
+        }
+
+      if(Region->CursorCol == Region->Width &&
+         (Region->Mode & LCD_REGION_WRAP) != 0)
+        {
+          LcdRegion_NewLine(Region);
+        }
+
+      //clipped at the end of the line or dropped past the last one
+      if(Region->CursorCol < Region->Width &&
+         Region->CursorRow < Region->Height)
+        {
+          Region->Text[(uint16_t)Region->CursorRow * Region->Width +
+           Region->CursorCol] = Data[i];
+          LcdRegion_Mark(Region, Region->CursorRow, Region->CursorCol);
+          Region->CursorCol++;
+          Stored++;
+        }
+    }
+
+  (void)LcdRegion_Flush(Region);
+
+  return Stored;
+}
+
+/******************************************************************************
+* Function : LcdRegion_Scroll()
+*//**
+* \b Description: Scroll the region text up. The cursor moves with the
+* text and the freed lines at the bottom are blank.<br/>
+* \b PRE-CONDITION: the region is created by LcdRegion_Create <br/>
+* @param Region a valid pointer to the region.
+* @param Lines The number of lines to scroll.
+* @return void
+******************************************************************************/
+extern void
+LcdRegion_Scroll(LcdRegion_t* const Region, const uint8_t Lines)
+{
+  if(Region == 0x00)
+    {
+      //TODO: handle this error
+      return;
+    }
+
+  LcdRegion_Shift(Region, Lines);
+
+  if(Region->CursorRow >= Lines)
+    {
+      Region->CursorRow -= Lines;
+    }
+  else
+    {
+      Region->CursorRow = 0;
+      Region->CursorCol = 0;
+    }
+
+  (void)LcdRegion_Flush(Region);
+}
+
+/******************************************************************************
+* Function : LcdRegion_Flush()
+*//**
+* \b Description: Send the cells of the region that changed since they were
+* last sent. A row that doesn't fit in the buffer of the display is kept for
+* the next call.<br/>
+* \b PRE-CONDITION: the region is created by LcdRegion_Create <br/>
+* @param Region a valid pointer to the region.
+* @return uint8_t 1 if the whole region is sent, 0 otherwise
+******************************************************************************/
+extern uint8_t
+LcdRegion_Flush(LcdRegion_t* const Region)
+{
+  if(Region == 0x00)
+    {
+      //TODO: handle this error
+      return 0;
+    }
+
+  uint8_t res = 1;
+  uint8_t Row;
+  uint8_t First;
+  uint8_t Size;
+
+  for(Row = 0; Row < Region->Height; Row++)
+    {
+      First = Region->First[Row];
+      if(First > Region->Last[Row]) continue;
+
+      Size = Region->Last[Row] - First + 1;
+      if(LcdDisplay_SetDataAt(Region->Display, Region->Row + Row,
+          Region->Col + First,
+          &Region->Text[(uint16_t)Row * Region->Width + First], Size,
+          0x00) == Size)
+        {
+          Region->First[Row] = LCD_REGION_CLEAN;
+          Region->Last[Row] = 0;
+        }
+      else
+        {
+          res = 0;
+        }
+    }
+
+  return res;
+}
+
+/******************************************************************************
+* Function : LcdRegion_NewLine()
+*//**
+* \b Description: Utility function to move the cursor to the start of the
+* next line, scrolling the region or parking the cursor below the last line
+* (where the text is dropped) at the end<br/>
+* @param Region a valid pointer to the region.
+* @return void
+******************************************************************************/
+static void
+LcdRegion_NewLine(LcdRegion_t* const Region)
+{
+  Region->CursorCol = 0;
+
+  if(Region->CursorRow + 1 < Region->Height)
+    {
+      Region->CursorRow++;
+    }
+  else if((Region->Mode & LCD_REGION_SCROLL) != 0 && Region->Height != 0)
+    {
+      LcdRegion_Shift(Region, 1);
+      Region->CursorRow = Region->Height - 1;
+    }
+  else
+    {
+      Region->CursorRow = Region->Height;
+    }
+}
+
+/******************************************************************************
+* Function : LcdRegion_Shift()
+*//**
+* \b Description: Utility function to move the region text up by some lines
+* and blank the lines freed at the bottom. Only the cells that change are
+* marked for rendering.<br/>
+* @param Region a valid pointer to the region.
+* @param Lines The number of lines (the whole region is blanked if it's
+* the height or more).
+* @return void
+******************************************************************************/
+static void
+LcdRegion_Shift(LcdRegion_t* const Region, uint8_t Lines)
+{
+  const uint8_t Width = Region->Width;
+  uint8_t* Target;
+  uint8_t Source;
+  uint8_t Row;
+  uint8_t Col;
+
+  if(Lines > Region->Height)
+    {
+      Lines = Region->Height;
+    }
+
+  for(Row = 0; Row < Region->Height; Row++)
+    {
+      Target = &Region->Text[(uint16_t)Row * Width];
+
+      for(Col = 0; Col < Width; Col++)
+        {
+          Source = LCD_REGION_BLANK;
+
+          if(Row + Lines < Region->Height)
+            {
+              Source = Target[(uint16_t)Lines * Width + Col];
+            }
+
+          if(Target[Col] != Source)
+            {
+              Target[Col] = Source;
+              LcdRegion_Mark(Region, Row, Col);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+* Function : LcdRegion_Mark()
+*//**
+* \b Description: Utility function to add a cell to the span of its row that
+* isn't rendered yet<br/>
+* @param Region a valid pointer to the region.
+* @param Row The row of the cell in the region.
+* @param Col The column of the cell in the region.
+* @return void
+******************************************************************************/
+static void
+LcdRegion_Mark(LcdRegion_t* const Region, uint8_t Row, uint8_t Col)
+{
+  if(Col < Region->First[Row])
+    {
+      Region->First[Row] = Col;
+    }
+
+  if(Col > Region->Last[Row])
+    {
+      Region->Last[Row] = Col;
+    }
+}
+/*****************************End of File ************************************/
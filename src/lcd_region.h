@@ -0,0 +1,82 @@
+/**
+ * @file lcd_region.h
+ * @author Mohamed Hassanin Mohamed
+ * @brief Text regions of the LCD displays: rectangular windows with their
+ * own cursor, line wrap or clipping and vertical scroll. A region keeps its
+ * text in a buffer of the application and sends only the cells that change
+ * through LcdDisplay_SetDataAt, so it doesn't move the cursor of 
+ * LcdDisplay_SetData nor switch the display to frames.
+ * @version 0.1
+ * @date 2021-04-20
+ */
+#ifndef LCD_REGION
+#define LCD_REGION
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "lcd_display.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LCD_REGION_CLIP 0x00 /**< drop the characters past the end of a line */
+#define LCD_REGION_WRAP 0x01 /**< continue a long line on the next one */
+#define LCD_REGION_SCROLL 0x02 /**< scroll up past the last line instead of
+                                    dropping the text */
+#define LCD_REGION_ROWS_MAX 4 /**< the rows of a region */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * A structure for a text region of a display. It's created by
+ * LcdRegion_Create and owned by the application.
+ */
+typedef struct LcdRegion
+{
+  LcdDisplay_t Display; /**< the display of the region */
+  uint8_t Row; /**< the first row of the region in the display */
+  uint8_t Col; /**< the first column of the region in the display */
+  uint8_t Width; /**< the columns of the region */
+  uint8_t Height; /**< the rows of the region */
+  uint8_t Mode; /**< LCD_REGION_CLIP or a mix of LCD_REGION_WRAP and
+                     LCD_REGION_SCROLL */
+  uint8_t CursorRow; /**< the row of the cursor in the region */
+  uint8_t CursorCol; /**< the column of the cursor in the region */
+  uint8_t First[LCD_REGION_ROWS_MAX]; /**< the first column of each row 
+                                         not rendered yet */
+  uint8_t Last[LCD_REGION_ROWS_MAX]; /**< the last column of each row not
+                                        rendered yet (before First if the 
+                                        row is rendered) */
+  uint8_t* Text; /**< Width * Height characters, row by row */
+} LcdRegion_t;
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern uint8_t LcdRegion_Create(LcdRegion_t* const Region,
+                               const LcdDisplay_t Display,
+                               const uint8_t Row,
+                               const uint8_t Col,
+                               const uint8_t Width,
+                               const uint8_t Height,
+                               const uint8_t Mode,
+                               uint8_t* const Text);
+extern void LcdRegion_Clear(LcdRegion_t* const Region);
+extern uint8_t LcdRegion_SetCursor(LcdRegion_t* const Region,
+                                   const uint8_t Row,
+                                   const uint8_t Col);
+extern uint8_t LcdRegion_Write(LcdRegion_t* const Region,
+                               const uint8_t* const Data,
+                               const uint8_t DataSize);
+extern void LcdRegion_Scroll(LcdRegion_t* const Region, const uint8_t Lines);
+extern uint8_t LcdRegion_Flush(LcdRegion_t* const Region);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end LCD_REGION */
+/*****************************End of File ************************************/
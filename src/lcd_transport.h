@@ -0,0 +1,63 @@
+/**
+ * @file lcd_transport.h
+ * @author Mohamed Hassanin Mohamed
+ * @brief The interface of the transports that carry bytes from the LCD
+ * display module to the LCD controller (direct GPIO, I2C backpack, ...).
+ * @version 0.1
+ * @date 2021-04-10
+ */
+#ifndef LCD_TRANSPORT
+#define LCD_TRANSPORT
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+struct LcdDisplayConfig;
+
+/**
+ * A structure for a transport. LcdDisplay_Update writes up to Burst bytes
+ * to a display through Write then calls Flush so that a transport can send
+ * them in one bus transaction.
+ */
+typedef struct LcdTransport
+{
+  /** prepares the transport of a display. It may be 0. */
+  void (*Init)(const struct LcdDisplayConfig* const Config);
+  /** writes a byte to a controller (0, or 1 for the second controller of a
+   * 40x4 display). Rs is 1 for data and 0 for commands. */
+  void (*Write)(const struct LcdDisplayConfig* const Config,
+                uint8_t Ctrl,
+                uint8_t Data,
+                uint8_t Rs);
+  /** sends the bytes written since the last flush. It may be 0. */
+  void (*Flush)(const struct LcdDisplayConfig* const Config);
+  /** the maximum number of bytes written in one update */
+  uint8_t Burst;
+  /** reads a byte from a controller: the busy flag and the address counter
+   * if Rs is 0, the char at the address counter if Rs is 1. It may be 0 if
+   * the transport can't read back (no R/W line). */
+  uint8_t (*Read)(const struct LcdDisplayConfig* const Config,
+                  uint8_t Ctrl,
+                  uint8_t Rs);
+} LcdTransport_t;
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern const LcdTransport_t LcdTransport_Dio; /**< direct GPIO (4-bit) */
+extern const LcdTransport_t LcdTransport_Pcf8574; /**< PCF8574 I2C backpack */
+extern const LcdTransport_t LcdTransport_Hc595; /**< 74HC595 over spi */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end LCD_TRANSPORT */
+/*****************************End of File ************************************/
@@ -0,0 +1,173 @@
+/**
+ * @file lcd_transport_dio.c
+ * @author Mohamed Hassanin
+ * @brief The direct GPIO transport of the LCD display module. Every pin is
+ * driven through the dio module.
+ * @version 0.1
+ * @date 2021-04-10
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lcd_display_cfg.h"
+/******************************************************************************
+ * Functions Prototypes
+ ******************************************************************************/
+static void LcdTransportDio_Write(const LcdDisplayConfig_t* const Config,
+ uint8_t Ctrl, uint8_t Data, uint8_t Rs);
+static uint8_t LcdTransportDio_Read(const LcdDisplayConfig_t* const Config,
+ uint8_t Ctrl, uint8_t Rs);
+static void LcdTransportDio_Delay(void);
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the direct GPIO transport. It writes one byte per update since the
+ * controller needs the update period to execute it. It reads back through
+ * the R/W channel if the display is scrubbed.
+ */
+const LcdTransport_t LcdTransport_Dio =
+{
+  .Init = 0x00,
+  .Write = LcdTransportDio_Write,
+  .Flush = 0x00,
+  .Burst = 1,
+  .Read = LcdTransportDio_Read
+};
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdTransportDio_Delay()
+*//**
+* \b Description: Utility function used to make a small software delay for
+* the enable pin cycle of the LCD Display <br/>
+* @return void
+******************************************************************************/
+static void
+LcdTransportDio_Delay(void)
+{
+  //dummy delay
+  uint8_t x = 0;
+  x++;
+  x++;
+  x++;
+}
+
+/******************************************************************************
+* Function : LcdTransportDio_Write()
+*//**
+* \b Description: Utility function to send a char to show or a command to
+* execute on the lcd display<br/>
+* \b PRE-CONDITION: The display channels are configured as outputs <br/>
+* @param Config a pointer to the configuration of the display.
+* @param Ctrl the controller (it selects the enable channel)
+* @param Data the command/char
+* @param Rs 1 for a char, 0 for a command
+* @return void
+******************************************************************************/
+static void
+LcdTransportDio_Write(const LcdDisplayConfig_t* const Config, uint8_t Ctrl,
+ uint8_t Data, uint8_t Rs)
+{
+  const DioChannel_t En = (Ctrl == 0) ? Config->En : Config->En2;
+  uint8_t DataCh;
+  uint8_t Nibble;
+
+  for(Nibble = 2; Nibble >= 1; Nibble--)
+    {
+      for(DataCh = 0; DataCh < LCD_DISPLAY_BITLEN; DataCh++)
+        {
+          if(Data & (1 << (DataCh + (LCD_DISPLAY_BITLEN * (Nibble - 1)))))
+            {
+              Dio_ChannelWrite(Config->Data[DataCh], DIO_STATE_HIGH);
+            }
+          else
+            {
+              Dio_ChannelWrite(Config->Data[DataCh], DIO_STATE_LOW);
+            }
+        }
+
+      if (Rs == 1)
+        {
+          Dio_ChannelWrite(Config->Rs, DIO_STATE_HIGH);
+        }
+      else
+        {
+          Dio_ChannelWrite(Config->Rs, DIO_STATE_LOW);
+        }
+
+      //latch
+      Dio_ChannelWrite(En, DIO_STATE_HIGH);
+      LcdTransportDio_Delay();
+      Dio_ChannelWrite(En, DIO_STATE_LOW);
+      LcdTransportDio_Delay();
+    }
+}
+
+/******************************************************************************
+* Function : LcdTransportDio_Read()
+*//**
+* \b Description: Utility function to read the status (busy flag and address
+* counter) or the char at the address counter of the lcd display. The data
+* channels are inputs while R/W is high and outputs again afterwards.<br/>
+* \b PRE-CONDITION: The R/W channel is configured as an output, low <br/>
+* @param Config a pointer to the configuration of the display.
+* @param Ctrl the controller (it selects the enable channel)
+* @param Rs 1 for the char, 0 for the status
+* @return uint8_t the byte read
+******************************************************************************/
+static uint8_t
+LcdTransportDio_Read(const LcdDisplayConfig_t* const Config, uint8_t Ctrl,
+ uint8_t Rs)
+{
+  const DioChannel_t En = (Ctrl == 0) ? Config->En : Config->En2;
+  uint8_t Data = 0;
+  uint8_t DataCh;
+  uint8_t Nibble;
+
+  for(DataCh = 0; DataCh < LCD_DISPLAY_BITLEN; DataCh++)
+    {
+      Dio_SetChannelDirection(Config->Data[DataCh], DIO_DIR_INPUT);
+    }
+
+  if (Rs == 1)
+    {
+      Dio_ChannelWrite(Config->Rs, DIO_STATE_HIGH);
+    }
+  else
+    {
+      Dio_ChannelWrite(Config->Rs, DIO_STATE_LOW);
+    }
+
+  Dio_ChannelWrite(Config->Rw, DIO_STATE_HIGH);
+
+  for(Nibble = 2; Nibble >= 1; Nibble--)
+    {
+      //the data is valid while EN is high
+      Dio_ChannelWrite(En, DIO_STATE_HIGH);
+      LcdTransportDio_Delay();
+
+      for(DataCh = 0; DataCh < LCD_DISPLAY_BITLEN; DataCh++)
+        {
+          if(Dio_ChannelRead(Config->Data[DataCh]) == DIO_STATE_HIGH)
+            {
+              Data |= (uint8_t)(1 << (DataCh + (LCD_DISPLAY_BITLEN *
+               (Nibble - 1))));
+            }
+        }
+
+      Dio_ChannelWrite(En, DIO_STATE_LOW);
+      LcdTransportDio_Delay();
+    }
+
+  Dio_ChannelWrite(Config->Rw, DIO_STATE_LOW);
+
+  for(DataCh = 0; DataCh < LCD_DISPLAY_BITLEN; DataCh++)
+    {
+      Dio_SetChannelDirection(Config->Data[DataCh], DIO_DIR_OUTPUT);
+    }
+
+  return Data;
+}
+/*****************************End of File ************************************/
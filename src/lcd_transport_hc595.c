@@ -0,0 +1,200 @@
+/**
+ * @file lcd_transport_hc595.c
+ * @author Mohamed Hassanin
+ * @brief The 74HC595 shift register transport of the LCD display module.
+ * The latch frames of the shift register (nibble, RS, EN high and EN low)
+ * are built from precomputed tables and a whole burst of bytes is shifted
+ * out through the spi in one write.
+ * @version 0.1
+ * @date 2021-04-12
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lcd_display_cfg.h"
+#include "spi.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/**
+ * The number of latch frames of one byte: for each nibble, a setup frame
+ * then EN high then EN low.
+ */
+#define LCD_HC595_FRAMES_PER_BYTE 6
+
+/**
+ * The size of the burst buffer of a display: the frames of each byte and 
+ * the gap before each byte but the first
+ */
+#define LCD_HC595_TX_SIZE (LCD_HC595_BURST * LCD_HC595_FRAMES_PER_BYTE + \
+ (LCD_HC595_BURST - 1) * LCD_HC595_GAP_FRAMES)
+
+#if LCD_HC595_TX_SIZE > 255
+#error "LCD_HC595_BURST x (6 + LCD_HC595_GAP_FRAMES) must not exceed 255"
+#endif
+
+/**
+ * The outputs of the shift register driving D4..D7 for a nibble
+ */
+#define LCD_HC595_NIBBLE(n) ((uint8_t)( \
+  (((n) & 0x01) ? LCD_HC595_D4 : 0) | \
+  (((n) & 0x02) ? LCD_HC595_D5 : 0) | \
+  (((n) & 0x04) ? LCD_HC595_D6 : 0) | \
+  (((n) & 0x08) ? LCD_HC595_D7 : 0)))
+/******************************************************************************
+ * Functions Prototypes
+ ******************************************************************************/
+static void LcdTransportHc595_Init(const LcdDisplayConfig_t* const Config);
+static void LcdTransportHc595_Write(const LcdDisplayConfig_t* const Config,
+ uint8_t Ctrl, uint8_t Data, uint8_t Rs);
+static void LcdTransportHc595_Flush(const LcdDisplayConfig_t* const Config);
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the 74HC595 shift register transport
+ */
+const LcdTransport_t LcdTransport_Hc595 =
+{
+  .Init = LcdTransportHc595_Init,
+  .Write = LcdTransportHc595_Write,
+  .Flush = LcdTransportHc595_Flush,
+  .Burst = LCD_HC595_BURST
+};
+
+/**
+ * @brief the data outputs of each nibble value
+ */
+static const uint8_t gNibble[16] =
+{
+  LCD_HC595_NIBBLE(0x0), LCD_HC595_NIBBLE(0x1),
+  LCD_HC595_NIBBLE(0x2), LCD_HC595_NIBBLE(0x3),
+  LCD_HC595_NIBBLE(0x4), LCD_HC595_NIBBLE(0x5),
+  LCD_HC595_NIBBLE(0x6), LCD_HC595_NIBBLE(0x7),
+  LCD_HC595_NIBBLE(0x8), LCD_HC595_NIBBLE(0x9),
+  LCD_HC595_NIBBLE(0xA), LCD_HC595_NIBBLE(0xB),
+  LCD_HC595_NIBBLE(0xC), LCD_HC595_NIBBLE(0xD),
+  LCD_HC595_NIBBLE(0xE), LCD_HC595_NIBBLE(0xF)
+};
+
+/**
+ * @brief the RS output of commands (index 0) and chars (index 1)
+ */
+static const uint8_t gRs[2] = {0, LCD_HC595_RS};
+
+/**
+ * @brief the EN output of the first and the second controller
+ */
+static const uint8_t gEn[2] = {LCD_HC595_EN, LCD_HC595_EN2};
+
+/**
+ * @brief the latch frames waiting for the next burst of each display
+ */
+static uint8_t gTx[LCD_DISPLAY_MAX][LCD_HC595_TX_SIZE];
+
+/**
+ * @brief the number of latch frames in gTx of each display
+ */
+static uint8_t gTxSize[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the last latch frame of the shift register of each display
+ */
+static uint8_t gLatch[LCD_DISPLAY_MAX];
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdTransportHc595_Init()
+*//**
+* \b Description: Utility function to clear the outputs of the shift
+* register of a display<br/>
+* @param Config a pointer to the configuration of the display.
+* @return void
+******************************************************************************/
+static void
+LcdTransportHc595_Init(const LcdDisplayConfig_t* const Config)
+{
+  gTxSize[Config->Display] = 0;
+  gLatch[Config->Display] = 0;
+
+  (void)Spi_Write(Config->BusAddress, &gLatch[Config->Display], 1);
+}
+
+/******************************************************************************
+* Function : LcdTransportHc595_Write()
+*//**
+* \b Description: Utility function to append the latch frames of a 
+* char/command to the next burst of a display. The setup frame of a nibble
+* is skipped when the outputs already hold it. After the first byte of a 
+* burst, idle frames give the controller the time to execute the previous
+* one.<br/>
+* @param Config a pointer to the configuration of the display.
+* @param Ctrl the controller (it selects the EN output)
+* @param Data the command/char
+* @param Rs 1 for a char, 0 for a command
+* @return void
+******************************************************************************/
+static void
+LcdTransportHc595_Write(const LcdDisplayConfig_t* const Config, uint8_t Ctrl,
+ uint8_t Data, uint8_t Rs)
+{
+  const LcdDisplay_t Display = Config->Display;
+  const uint8_t En = gEn[Ctrl & 0x01];
+  const uint8_t High = gNibble[Data >> 4] | gRs[Rs & 0x01];
+  const uint8_t Low = gNibble[Data & 0x0F] | gRs[Rs & 0x01];
+  uint8_t* Frame;
+  uint8_t Gap;
+
+  if(gTxSize[Display] + LCD_HC595_GAP_FRAMES + LCD_HC595_FRAMES_PER_BYTE >
+     LCD_HC595_TX_SIZE)
+    {
+      LcdTransportHc595_Flush(Config);
+    }
+
+  Frame = &gTx[Display][gTxSize[Display]];
+
+  //the outputs stay as they are (EN low) during the gap
+  for(Gap = 0; gTxSize[Display] != 0 && Gap < LCD_HC595_GAP_FRAMES; Gap++)
+    {
+      *Frame++ = gLatch[Display];
+    }
+
+  //the data and RS must be stable before EN rises
+  if(gLatch[Display] != High)
+    {
+      *Frame++ = High;
+    }
+  *Frame++ = High | En;
+  *Frame++ = High;
+  *Frame++ = Low;
+  *Frame++ = Low | En;
+  *Frame++ = Low;
+
+  gTxSize[Display] = (uint8_t)(Frame - gTx[Display]);
+  gLatch[Display] = Low;
+}
+
+/******************************************************************************
+* Function : LcdTransportHc595_Flush()
+*//**
+* \b Description: Utility function to shift out the pending latch frames of
+* a display in one spi burst<br/>
+* @param Config a pointer to the configuration of the display.
+* @return void
+******************************************************************************/
+static void
+LcdTransportHc595_Flush(const LcdDisplayConfig_t* const Config)
+{
+  const LcdDisplay_t Display = Config->Display;
+
+  if(gTxSize[Display] == 0) return;
+
+  if(Spi_Write(Config->BusAddress, gTx[Display], gTxSize[Display]) == 0)
+    {
+      //TODO: handle this error
+    }
+
+  gTxSize[Display] = 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,168 @@
+/**
+ * @file lcd_transport_pcf8574.c
+ * @author Mohamed Hassanin
+ * @brief The PCF8574 I2C backpack transport of the LCD display module.
+ * Every byte is turned into the port states of the expander (nibble, RS,
+ * EN high and EN low) and a whole burst of bytes is sent in one I2C write.
+ * @version 0.1
+ * @date 2021-04-10
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lcd_display_cfg.h"
+#include "i2c.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/**
+ * The number of port states of one byte: for each nibble, a setup state
+ * then EN high then EN low.
+ */
+#define LCD_PCF8574_STATES_PER_BYTE 6
+
+/**
+ * The size of the transaction buffer of a display
+ */
+#define LCD_PCF8574_TX_SIZE (LCD_PCF8574_BURST * LCD_PCF8574_STATES_PER_BYTE)
+/******************************************************************************
+ * Functions Prototypes
+ ******************************************************************************/
+static void LcdTransportPcf8574_Init(const LcdDisplayConfig_t* const Config);
+static void LcdTransportPcf8574_Write(const LcdDisplayConfig_t* const Config,
+ uint8_t Ctrl, uint8_t Data, uint8_t Rs);
+static void LcdTransportPcf8574_Flush(const LcdDisplayConfig_t* const Config);
+static void LcdTransportPcf8574_Put(LcdDisplay_t Display, uint8_t State);
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the PCF8574 I2C backpack transport
+ */
+const LcdTransport_t LcdTransport_Pcf8574 =
+{
+  .Init = LcdTransportPcf8574_Init,
+  .Write = LcdTransportPcf8574_Write,
+  .Flush = LcdTransportPcf8574_Flush,
+  .Burst = LCD_PCF8574_BURST
+};
+
+/**
+ * @brief the port states waiting for the next transaction of each display
+ */
+static uint8_t gTx[LCD_DISPLAY_MAX][LCD_PCF8574_TX_SIZE];
+
+/**
+ * @brief the number of port states in gTx of each display
+ */
+static uint8_t gTxSize[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the last port state of the expander of each display
+ */
+static uint8_t gPort[LCD_DISPLAY_MAX];
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : LcdTransportPcf8574_Init()
+*//**
+* \b Description: Utility function to reset the expander of a display: all
+* the lines low and the backlight on<br/>
+* @param Config a pointer to the configuration of the display.
+* @return void
+******************************************************************************/
+static void
+LcdTransportPcf8574_Init(const LcdDisplayConfig_t* const Config)
+{
+  gTxSize[Config->Display] = 0;
+  gPort[Config->Display] = LCD_PCF8574_BL;
+
+  (void)I2c_Write(Config->BusAddress, &gPort[Config->Display], 1);
+}
+
+/******************************************************************************
+* Function : LcdTransportPcf8574_Put()
+*//**
+* \b Description: Utility function to append a port state to the next
+* transaction of a display<br/>
+* @param Display The id of the display.
+* @param State The port state.
+* @return void
+******************************************************************************/
+static void
+LcdTransportPcf8574_Put(LcdDisplay_t Display, uint8_t State)
+{
+  gTx[Display][gTxSize[Display]] = State;
+  gTxSize[Display]++;
+  gPort[Display] = State;
+}
+
+/******************************************************************************
+* Function : LcdTransportPcf8574_Write()
+*//**
+* \b Description: Utility function to append a char/command to the next
+* transaction of a display. The setup state of a nibble is skipped when the
+* port already holds it.<br/>
+* @param Config a pointer to the configuration of the display.
+* @param Ctrl the controller (it selects the enable bit)
+* @param Data the command/char
+* @param Rs 1 for a char, 0 for a command
+* @return void
+******************************************************************************/
+static void
+LcdTransportPcf8574_Write(const LcdDisplayConfig_t* const Config, uint8_t Ctrl,
+ uint8_t Data, uint8_t Rs)
+{
+  const LcdDisplay_t Display = Config->Display;
+  const uint8_t En = (Ctrl == 0) ? LCD_PCF8574_EN : LCD_PCF8574_EN2;
+  uint8_t Nibble;
+  uint8_t State;
+
+  if(gTxSize[Display] + LCD_PCF8574_STATES_PER_BYTE > LCD_PCF8574_TX_SIZE)
+    {
+      LcdTransportPcf8574_Flush(Config);
+    }
+
+  for(Nibble = 2; Nibble >= 1; Nibble--)
+    {
+      State = (uint8_t)(((Data >> (LCD_DISPLAY_BITLEN * (Nibble - 1))) & 0x0F)
+       << LCD_PCF8574_DATA_SHIFT);
+      State |= LCD_PCF8574_BL;
+      if(Rs == 1) State |= LCD_PCF8574_RS;
+
+      //the data and RS must be stable before EN rises
+      if(gPort[Display] != State)
+        {
+          LcdTransportPcf8574_Put(Display, State);
+        }
+
+      //latch
+      LcdTransportPcf8574_Put(Display, State | En);
+      LcdTransportPcf8574_Put(Display, State);
+    }
+}
+
+/******************************************************************************
+* Function : LcdTransportPcf8574_Flush()
+*//**
+* \b Description: Utility function to send the pending port states of a
+* display in one I2C write<br/>
+* @param Config a pointer to the configuration of the display.
+* @return void
+******************************************************************************/
+static void
+LcdTransportPcf8574_Flush(const LcdDisplayConfig_t* const Config)
+{
+  const LcdDisplay_t Display = Config->Display;
+
+  if(gTxSize[Display] == 0) return;
+
+  if(I2c_Write(Config->BusAddress, gTx[Display], gTxSize[Display]) == 0)
+    {
+      //TODO: handle this error
+    }
+
+  gTxSize[Display] = 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,36 @@
+/**
+ * @file spi.h
+ * @author Mohamed Hassanin
+ * @brief The interface definition for the spi.
+ * This is the header file for the definition of the interface for an spi
+ * master peripheral on a standard microcontroller used as a byte sink.
+ * @version 0.1
+ * @date 2021-04-12
+*/
+#ifndef SPI_H_
+#define SPI_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * Shifts Size bytes out on the Channel in one burst. The chip select of the
+ * channel is strobed after every byte so that a shift register latches each
+ * byte on its outputs. It returns 1 if the bytes are sent.
+ */
+extern uint8_t Spi_Write(uint8_t Channel, const uint8_t* const Data,
+                         uint8_t Size);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* SPI_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,113 @@
+/**
+ * @file spi_loopback.c
+ * @author Mohamed Hassanin
+ * @brief A host loopback of the spi interface. The bytes shifted out are
+ * kept so that they can be read back and measured.
+ * @version 0.1
+ * @date 2021-04-12
+*/
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include "spi_loopback.h"
+#include "circ_buffer.h"
+/**********************************************************************
+* Module Variable Definitions
+**********************************************************************/
+/**
+* The statistics of the recorded bursts
+*/
+static SpiLoopbackStats_t gStats;
+
+/**
+* The memory of the shifted bytes. One byte is wasted by the circular buffer.
+*/
+static uint8_t gData[SPI_LOOPBACK_SIZE - 1U];
+
+/**
+* The shifted bytes not read back yet. The oldest ones are dropped when
+* it's full.
+*/
+static CircBuff_t gBuff = {0, 0, gData, (uint8_t)(SPI_LOOPBACK_SIZE - 1U)};
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Spi_Write()
+*//**
+* \b Description: Keeps the bytes instead of shifting them out<br/>
+* @param Channel the spi channel
+* @param Data a pointer to the bytes to shift out
+* @param Size the number of bytes
+* @return uint8_t 1 always
+**********************************************************************/
+extern uint8_t
+Spi_Write(uint8_t Channel, const uint8_t* const Data, uint8_t Size)
+{
+	uint8_t i;
+	uint8_t Dropped;
+
+	gStats.Bursts++;
+	gStats.Bytes += Size;
+	gStats.LastChannel = Channel;
+
+	for(i = 0; i < Size; i++)
+	{
+		if(CircBuff_Enqueue(&gBuff, Data[i]) == 0)
+		{
+			(void)CircBuff_Dequeue(&gBuff, &Dropped);
+			(void)CircBuff_Enqueue(&gBuff, Data[i]);
+		}
+	}
+
+	return 1;
+}
+
+/**********************************************************************
+* Function : SpiLoopback_Reset()
+*//**
+* \b Description: Clears the recorded statistics and bytes<br/>
+* @return void
+**********************************************************************/
+extern void
+SpiLoopback_Reset(void)
+{
+	gStats.Bursts = 0;
+	gStats.Bytes = 0;
+	gStats.LastChannel = 0;
+	CircBuff_Reset(&gBuff);
+}
+
+/**********************************************************************
+* Function : SpiLoopback_GetStats()
+*//**
+* \b Description: Returns the recorded statistics<br/>
+* @return const SpiLoopbackStats_t* a pointer to the statistics
+**********************************************************************/
+extern const SpiLoopbackStats_t*
+SpiLoopback_GetStats(void)
+{
+	return &gStats;
+}
+
+/**********************************************************************
+* Function : SpiLoopback_Read()
+*//**
+* \b Description: Reads back the oldest shifted bytes<br/>
+* @param Data a pointer to store the bytes in
+* @param Size the maximum number of bytes to read
+* @return uint16_t the number of bytes read
+**********************************************************************/
+extern uint16_t
+SpiLoopback_Read(uint8_t* const Data, uint16_t Size)
+{
+	uint16_t i = 0;
+
+	while(i < Size && CircBuff_Dequeue(&gBuff, &Data[i]) == 1)
+	{
+		i++;
+	}
+
+	return i;
+}
+/*************** END OF FILE ********************************/
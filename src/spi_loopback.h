@@ -0,0 +1,51 @@
+/**
+ * @file spi_loopback.h
+ * @author Mohamed Hassanin
+ * @brief A host loopback of the spi interface. The bytes shifted out are
+ * kept so that they can be read back and measured.
+ * @version 0.1
+ * @date 2021-04-12
+*/
+#ifndef SPI_LOOPBACK_H_
+#define SPI_LOOPBACK_H_
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "spi.h"
+/**********************************************************************
+* Preprocessor Constants
+**********************************************************************/
+/**
+* Defines the number of shifted bytes kept for reading back.
+*/
+#define SPI_LOOPBACK_SIZE 256U
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+* Defines the statistics recorded by the loopback.
+*/
+typedef struct
+{
+	uint32_t Bursts; /**< the number of Spi_Write calls */
+	uint32_t Bytes; /**< the number of shifted bytes */
+	uint8_t LastChannel; /**< the channel of the last burst */
+}SpiLoopbackStats_t;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern void SpiLoopback_Reset(void);
+extern const SpiLoopbackStats_t* SpiLoopback_GetStats(void);
+extern uint16_t SpiLoopback_Read(uint8_t* const Data, uint16_t Size);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* SPI_LOOPBACK_H_*/
+/*************** END OF FILE ********************************/
@@ -0,0 +1,9 @@
+/**
+ * @file dio.h
+ * @author Mohamed Hassanin
+ * @brief Forwards the dio interface included by lcd_display_cfg.h (as
+ * "../dio/dio.h") to the copy in src for the host build.
+ * @version 0.1
+ * @date 2021-04-22
+ */
+#include "../../src/dio.h"
@@ -0,0 +1,220 @@
+/**
+ * @file lcd_display_40x4.c
+ * @author Mohamed Hassanin
+ * @brief Host check of a 40x4 panel on the PCF8574 backpack. The upper and
+ * the lower rows are two controllers behind two enable lines: the bytes of a
+ * row must only be latched by its controller, at the DDRAM address of the
+ * geometry, and the updates must service both controllers in turn so that
+ * two rows take as many updates as one.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "lcd_display.h"
+#include "i2c_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define QUAD_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define QUAD_ADDRESS 0x27 /**< the i2c address of the backpack */
+#define QUAD_ROW_0 "upper controller, row 0" /**< the text of row 0 */
+#define QUAD_ROW_3 "lower controller, row 3" /**< the text of row 3 */
+#define QUAD_TEXT_SIZE 23 /**< the characters of a row text */
+#define QUAD_LINE_1 0x40 /**< the DDRAM address of the second line */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief a 40x4 display on the backpack
+ */
+static const LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX] =
+{
+  {
+    .Display = LCD_DISPLAY_0,
+    .Width = 40,
+    .Height = 4,
+    .Geometry = &LcdGeometry_40x4,
+    .Transport = &LcdTransport_Pcf8574,
+    .BusAddress = QUAD_ADDRESS,
+    .Rom = LCD_ROM_A00,
+    .ScrubBudget = 0,
+    .Locations = 0x00
+  }
+};
+
+/**
+ * @brief the enable line of each controller
+ */
+static const uint8_t gEnable[HD44780_MODEL_CTRL_MAX] =
+{
+  LCD_PCF8574_EN, LCD_PCF8574_EN2
+};
+
+/**
+ * @brief the failed checks, the port state before the next transaction and
+ * the nibble latched by each controller (Half is 1 after a high nibble)
+ */
+static uint32_t gFailed;
+static uint8_t gPort;
+static uint8_t gHigh[HD44780_MODEL_CTRL_MAX];
+static uint8_t gHalf[HD44780_MODEL_CTRL_MAX];
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Quad_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Quad_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Quad_Decode()
+*//**
+* \b Description: Latch the bytes of a transaction into the model of their
+* controller. A falling edge of an enable line latches a nibble of the port
+* into its controller. It fits I2cStubHook_t.<br/>
+* @param Address The i2c address of the transaction.
+* @param Data The port states.
+* @param Size The number of port states.
+* @return void
+******************************************************************************/
+static void
+Quad_Decode(uint8_t Address, const uint8_t* const Data, uint8_t Size)
+{
+  uint8_t Nibble;
+  uint8_t Ctrl;
+  uint8_t i;
+
+  (void)Address;
+
+  for(i = 0; i < Size; i++)
+    {
+      for(Ctrl = 0; Ctrl < HD44780_MODEL_CTRL_MAX; Ctrl++)
+        {
+          if(!((gPort & gEnable[Ctrl]) && !(Data[i] & gEnable[Ctrl])))
+            {
+              continue;
+            }
+
+          Nibble = (uint8_t)(gPort >> LCD_PCF8574_DATA_SHIFT);
+          if(gHalf[Ctrl] == 0)
+            {
+              gHigh[Ctrl] = Nibble;
+              gHalf[Ctrl] = 1;
+            }
+          else
+            {
+              gHalf[Ctrl] = 0;
+              Hd44780Model_LatchCtrl(Ctrl, (gPort & LCD_PCF8574_RS) != 0,
+               (uint8_t)((gHigh[Ctrl] << 4) | Nibble));
+            }
+        }
+
+      gPort = Data[i];
+    }
+}
+
+/******************************************************************************
+* Function : Quad_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return uint32_t the number of updates with pending work
+******************************************************************************/
+static uint32_t
+Quad_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < QUAD_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+
+  return Update;
+}
+
+/******************************************************************************
+* Function : Quad_Match()
+*//**
+* \b Description: Check the DDRAM of a controller from an address against a
+* text<br/>
+* @param Ctrl The controller.
+* @param Address The DDRAM address of the first character.
+* @param Text The text, 0 terminated.
+* @return int 1 if the DDRAM holds the text, 0 otherwise
+******************************************************************************/
+static int
+Quad_Match(uint8_t Ctrl, uint8_t Address, const char* const Text)
+{
+  return memcmp(&Hd44780Model_GetCtrl(Ctrl)->Ddram[Address], Text,
+   strlen(Text)) == 0;
+}
+
+int
+main(void)
+{
+  const I2cStubStats_t* const Stats = I2cStub_GetStats();
+  const Hd44780Model_t* const Upper = Hd44780Model_GetCtrl(0);
+  const Hd44780Model_t* const Lower = Hd44780Model_GetCtrl(1);
+  uint8_t Width;
+  uint8_t Height;
+  uint32_t Updates;
+
+  LcdDisplay_Init(gConfig);
+  (void)Quad_Flush();
+  Quad_Check(LcdDisplay_GetSize(LCD_DISPLAY_0, &Width, &Height) == 1 &&
+   Width == 40 && Height == 4, "the size of the panel");
+  gPort = Stats->Last[Stats->LastSize - 1];
+  I2cStub_Reset();
+  Hd44780Model_Reset();
+  I2cStub_SetHook(Quad_Decode);
+
+  //row 0 is the first line of the upper controller, row 3 the second line
+  //of the lower one
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)QUAD_ROW_0,
+   QUAD_TEXT_SIZE, 0x00);
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 3, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)QUAD_ROW_3,
+   QUAD_TEXT_SIZE, 0x00);
+
+  //a cursor command and the text per controller: both controllers take a
+  //burst per update
+  Updates = Quad_Flush() + 1;
+  printf("%u updates, %u transactions of %u bytes\n", (unsigned)Updates,
+   (unsigned)Stats->Transactions, (unsigned)Stats->Bytes);
+  Quad_Check(Updates == (1 + QUAD_TEXT_SIZE + LCD_PCF8574_BURST - 1) /
+   LCD_PCF8574_BURST, "the controllers flushed in parallel");
+  Quad_Check(Stats->LastAddress == QUAD_ADDRESS, "the backpack addressed");
+
+  Quad_Check(Upper->Commands == 1 && Upper->Chars == QUAD_TEXT_SIZE &&
+   Lower->Commands == 1 && Lower->Chars == QUAD_TEXT_SIZE,
+   "each byte latched by its controller");
+  Quad_Check(Quad_Match(0, 0, QUAD_ROW_0), "row 0 on the upper controller");
+  Quad_Check(Quad_Match(1, QUAD_LINE_1, QUAD_ROW_3),
+   "row 3 on the lower controller");
+  Quad_Check(Upper->Ddram[QUAD_LINE_1] == HD44780_MODEL_BLANK &&
+   Lower->Ddram[0] == HD44780_MODEL_BLANK, "the other lines untouched");
+
+  I2cStub_SetHook(0x00);
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
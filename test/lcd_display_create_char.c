@@ -0,0 +1,138 @@
+/**
+ * @file lcd_display_create_char.c
+ * @author Mohamed Hassanin
+ * @brief Host check of LcdDisplay_CreateChar against a full buffer. A
+ * character that doesn't fit must be refused whole, without a sequence
+ * number, and one that fits must reach the display with all its rows.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CHAR_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define CHAR_SEQ_UNSET 0xA5A5A5A5U /**< a sequence number no write gives */
+#define CHAR_ROWS 7 /**< the rows written by LcdDisplay_CreateChar */
+#define CHAR_BYTES (CHAR_ROWS * 3) /**< an address command and a row each */
+#define CHAR_CGRAM_MASK 0xC0 /**< the bits of a set CGRAM address command */
+#define CHAR_CGRAM_CMD 0x40 /**< a set CGRAM address command */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the failed checks and the set CGRAM address commands latched
+ */
+static uint32_t gFailed;
+static uint32_t gCgramCmds;
+
+/**
+ * @brief a custom character
+ */
+static const uint8_t gBell[CHAR_ROWS] = {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00,
+                                         0x04};
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Char_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Char_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Char_Latch()
+*//**
+* \b Description: Count the set CGRAM address commands latched<br/>
+* @param Rs 1 for a character, 0 for a command.
+* @param Byte The latched byte.
+* @return void
+******************************************************************************/
+static void
+Char_Latch(uint8_t Rs, uint8_t Byte)
+{
+  if(Rs == 0 && (Byte & CHAR_CGRAM_MASK) == CHAR_CGRAM_CMD)
+    {
+      gCgramCmds++;
+    }
+}
+
+/******************************************************************************
+* Function : Char_Drain()
+*//**
+* \b Description: Update the display until at most Pending bytes are left in
+* its buffers<br/>
+* @param Pending The bytes to leave.
+* @return void
+******************************************************************************/
+static void
+Char_Drain(uint16_t Pending)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < CHAR_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_GetPending(LCD_DISPLAY_0) <= Pending) break;
+      (void)LcdDisplay_Update();
+    }
+}
+
+int
+main(void)
+{
+  LcdDisplaySeq_t Seq = CHAR_SEQ_UNSET;
+  uint16_t Full;
+  uint16_t Pending;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Char_Drain(0);
+  DioStub_SetLatch(Char_Latch);
+
+  //fill the buffer, then free less than a character
+  while(LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"x", 1, 0x00) != 0);
+  Full = LcdDisplay_GetPending(LCD_DISPLAY_0);
+  Char_Drain(Full - CHAR_BYTES / 2);
+
+  Pending = LcdDisplay_GetPending(LCD_DISPLAY_0);
+  Char_Check(LcdDisplay_CreateChar(LCD_DISPLAY_0, 0, gBell, &Seq) == 0,
+   "refuse a character that doesn't fit");
+  Char_Check(Seq == CHAR_SEQ_UNSET, "no number from a refused character");
+  Char_Check(LcdDisplay_GetPending(LCD_DISPLAY_0) == Pending,
+   "nothing enqueued from a refused character");
+
+  //free enough for a character
+  Char_Drain(Full - CHAR_BYTES);
+
+  Pending = LcdDisplay_GetPending(LCD_DISPLAY_0);
+  Char_Check(LcdDisplay_CreateChar(LCD_DISPLAY_0, 0, gBell, &Seq) == 1,
+   "enqueue a character that fits");
+  Char_Check(Seq != CHAR_SEQ_UNSET, "a number from an enqueued character");
+  Char_Check(LcdDisplay_GetPending(LCD_DISPLAY_0) == Pending + CHAR_BYTES,
+   "every row of the character enqueued");
+
+  Char_Drain(0);
+  Char_Check(LcdDisplay_IsComplete(LCD_DISPLAY_0, Seq) == 1,
+   "the character is complete once flushed");
+  Char_Check(gCgramCmds == CHAR_ROWS, "every row of the character latched");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,140 @@
+/**
+ * @file lcd_display_frame.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the frames. Once a frame is committed, only the cells
+ * that differ from the display must reach the transport, and a write that
+ * changes no cell must not send anything.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define FRAME_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define FRAME_LINE_1 0x40 /**< the DDRAM address of the second row */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Frame_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Frame_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Frame_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Frame_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < FRAME_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+/******************************************************************************
+* Function : Frame_Write()
+*//**
+* \b Description: Commit a frame of two rows and flush it<br/>
+* @param Row0 The text of the first row, 0 terminated.
+* @param Row1 The text of the second row, 0 terminated.
+* @return void
+******************************************************************************/
+static void
+Frame_Write(const char* const Row0, const char* const Row1)
+{
+  LcdDisplay_BeginFrame(LCD_DISPLAY_0);
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)Row0,
+   (uint8_t)strlen(Row0), 0x00);
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)Row1,
+   (uint8_t)strlen(Row1), 0x00);
+  LcdDisplay_EndFrame(LCD_DISPLAY_0, 0x00);
+  Frame_Flush();
+}
+
+int
+main(void)
+{
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  LcdDisplaySeq_t Seq;
+  uint8_t Width;
+  uint8_t Height;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Frame_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+  (void)LcdDisplay_GetSize(LCD_DISPLAY_0, &Width, &Height);
+
+  Frame_Write("Hello world", "frame 1");
+  Frame_Check(Hd44780Model_Match(0, "Hello world") &&
+   Hd44780Model_Match(FRAME_LINE_1, "frame 1"), "the first frame");
+
+  //2 cells differ: a cursor command and a character each
+  Hd44780Model_Reset();
+  Frame_Write("Hello World", "frame 2");
+  printf("second frame: %u characters, %u commands\n",
+   (unsigned)Model->Chars, (unsigned)Model->Commands);
+  Frame_Check(Model->Chars == 2 && Model->Commands <= 2,
+   "only the changed cells sent");
+  Frame_Check(Model->Ddram[6] == 'W' && Model->Ddram[FRAME_LINE_1 + 6] == '2',
+   "the changed cells");
+
+  //outside a transaction the writes go to the committed frame; past the
+  //end of the row they change nothing
+  Hd44780Model_Reset();
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, Width - 1, 0x00);
+  Frame_Check(LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"!?", 2,
+   0x00) == 1, "clip a write of the committed frame");
+  Frame_Flush();
+  Frame_Check(Model->Chars == 1 && Model->Ddram[Width - 1] == '!',
+   "the clipped write");
+
+  Hd44780Model_Reset();
+  Frame_Check(LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"?", 1,
+   &Seq) == 0, "no write past the end of the row");
+  Frame_Check(LcdDisplay_HasWork() == 0 &&
+   LcdDisplay_IsComplete(LCD_DISPLAY_0, Seq) == 1,
+   "no frame to flush without a change");
+  Frame_Check(LcdDisplay_Update() == 0 && Model->Chars == 0 &&
+   Model->Commands == 0, "nothing sent without a change");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
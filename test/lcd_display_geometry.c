@@ -0,0 +1,195 @@
+/**
+ * @file lcd_display_geometry.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the panel geometries. Every cell of a panel must land
+ * at the DDRAM address of its datasheet (e.g. the split halves of a 16x1
+ * panel or the interleaved rows of a 20x4 one) and the cursor must refuse
+ * the positions outside the panel.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define GEOMETRY_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define GEOMETRY_ROW_MAX 4 /**< the rows of the largest panel checked */
+#define GEOMETRY_WIDTH_MAX 40 /**< the columns of the largest panel checked */
+#define GEOMETRY_FIRST '!' /**< the character of the first cell */
+#define GEOMETRY_CHARS 90 /**< the printable characters from the first one */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief a panel and the DDRAM addresses of its datasheet
+ */
+typedef struct
+{
+  const LcdGeometry_t* Geometry; /**< the geometry under check */
+  uint8_t Width; /**< the characters per row */
+  uint8_t Height; /**< the rows */
+  uint8_t Split; /**< the column of the second half of a row, 0 for none */
+  uint8_t Start[GEOMETRY_ROW_MAX][2]; /**< the address of each half */
+} GeometryCase_t;
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the panels of the check, from their datasheets
+ */
+static const GeometryCase_t gCases[] =
+{
+  {&LcdGeometry_8x1, 8, 1, 0, {{0x00}}},
+  {&LcdGeometry_16x1, 16, 1, 8, {{0x00, 0x40}}},
+  {&LcdGeometry_16x2, 16, 2, 0, {{0x00}, {0x40}}},
+  {&LcdGeometry_16x4, 16, 4, 0, {{0x00}, {0x40}, {0x10}, {0x50}}},
+  {&LcdGeometry_20x4, 20, 4, 0, {{0x00}, {0x40}, {0x14}, {0x54}}},
+  {&LcdGeometry_24x2, 24, 2, 0, {{0x00}, {0x40}}},
+  {&LcdGeometry_40x2, 40, 2, 0, {{0x00}, {0x40}}}
+};
+
+/**
+ * @brief the configuration of the display: the pins of the default one
+ * with the geometry under check
+ */
+static LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Geometry_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @param Case The case of the check.
+* @return void
+******************************************************************************/
+static void
+Geometry_Check(int Passed, const char* const Name,
+               const GeometryCase_t* const Case)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s (%ux%u)\n", Name, (unsigned)Case->Width,
+       (unsigned)Case->Height);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Geometry_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Geometry_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < GEOMETRY_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+/******************************************************************************
+* Function : Geometry_Run()
+*//**
+* \b Description: Fill a panel row by row and check every cell at its
+* datasheet address<br/>
+* @param Case The panel.
+* @return void
+******************************************************************************/
+static void
+Geometry_Run(const GeometryCase_t* const Case)
+{
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  uint8_t Text[GEOMETRY_WIDTH_MAX];
+  uint8_t Row;
+  uint8_t Col;
+  uint8_t Half;
+  uint8_t Address;
+  uint8_t Cell = 0;
+
+  gConfig[LCD_DISPLAY_0].Width = Case->Width;
+  gConfig[LCD_DISPLAY_0].Height = Case->Height;
+  gConfig[LCD_DISPLAY_0].Geometry = Case->Geometry;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(gConfig);
+  Geometry_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  for(Row = 0; Row < Case->Height; Row++)
+    {
+      for(Col = 0; Col < Case->Width; Col++)
+        {
+          Text[Col] = (uint8_t)(GEOMETRY_FIRST +
+           (Row * Case->Width + Col) % GEOMETRY_CHARS);
+        }
+
+      Geometry_Check(LcdDisplay_SetCursor(LCD_DISPLAY_0, Row, 0, 0x00) == 1 &&
+       LcdDisplay_SetData(LCD_DISPLAY_0, Text, Case->Width, 0x00) ==
+       Case->Width, "the rows written", Case);
+      Geometry_Flush();
+    }
+
+  for(Row = 0; Row < Case->Height; Row++)
+    {
+      for(Col = 0; Col < Case->Width; Col++)
+        {
+          Half = (Case->Split != 0 && Col >= Case->Split);
+          Address = (uint8_t)(Case->Start[Row][Half] +
+           Col - Half * Case->Split);
+
+          if(Model->Ddram[Address] !=
+             (uint8_t)(GEOMETRY_FIRST + Cell % GEOMETRY_CHARS))
+            {
+              printf("row %u col %u: 0x%02X at 0x%02X\n", (unsigned)Row,
+               (unsigned)Col, (unsigned)Model->Ddram[Address],
+               (unsigned)Address);
+              Geometry_Check(0, "a cell at its address", Case);
+            }
+
+          Cell++;
+        }
+    }
+
+  Geometry_Check(Model->Chars == Cell, "no character outside the panel",
+   Case);
+  Geometry_Check(LcdDisplay_SetCursor(LCD_DISPLAY_0, Case->Height, 0,
+   0x00) == 0 && LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, Case->Width,
+   0x00) == 0, "no cursor outside the panel", Case);
+}
+
+int
+main(void)
+{
+  uint8_t i;
+
+  gConfig[LCD_DISPLAY_0] = LcdDisplay_GetConfig()[LCD_DISPLAY_0];
+
+  for(i = 0; i < sizeof(gCases) / sizeof(gCases[0]); i++)
+    {
+      Geometry_Run(&gCases[i]);
+    }
+
+  printf("%u panels checked\n", (unsigned)i);
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,176 @@
+/**
+ * @file lcd_display_hc595.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the 74HC595 shift register transport over the spi
+ * loopback. An update must shift out one burst of LCD_HC595_BURST bytes
+ * (one byte as configured), each byte as 6 latch frames less the setup
+ * frame of the high nibble when the outputs already hold it, and the 
+ * frames must latch the bytes that were written.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "spi_loopback.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HC595_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define HC595_CHANNEL 1 /**< the spi channel of the shift register */
+#define HC595_TEXT "33333333" /**< characters with the same two nibbles */
+#define HC595_TEXT_SIZE 8 /**< the characters of HC595_TEXT */
+#define HC595_CURSOR 0xC0 /**< the cursor command of the second row */
+#define HC595_DATA_SHIFT 4 /**< the outputs of D4..D7 are the high nibble */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief a 16x2 display on the shift register
+ */
+static const LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX] =
+{
+  {
+    .Display = LCD_DISPLAY_0,
+    .Width = 16,
+    .Height = 2,
+    .Geometry = &LcdGeometry_16x2,
+    .Transport = &LcdTransport_Hc595,
+    .BusAddress = HC595_CHANNEL,
+    .Rom = LCD_ROM_A00,
+    .ScrubBudget = 0,
+    .Locations = 0x00
+  }
+};
+
+/**
+ * @brief the failed checks and the outputs before the next frame
+ */
+static uint32_t gFailed;
+static uint8_t gOutputs;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Hc595_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Hc595_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Hc595_Decode()
+*//**
+* \b Description: Latch the bytes of the shifted frames into the model. A
+* falling edge of EN latches a nibble of the outputs.<br/>
+* @return uint8_t the number of bytes latched
+******************************************************************************/
+static uint8_t
+Hc595_Decode(void)
+{
+  uint8_t Frames[SPI_LOOPBACK_SIZE];
+  uint16_t Size;
+  uint16_t i;
+  uint8_t Bytes = 0;
+  uint8_t High = 0;
+  uint8_t Half = 0;
+  uint8_t Nibble;
+
+  Size = SpiLoopback_Read(Frames, sizeof(Frames));
+
+  for(i = 0; i < Size; i++)
+    {
+      if((gOutputs & LCD_HC595_EN) && !(Frames[i] & LCD_HC595_EN))
+        {
+          Nibble = (uint8_t)(gOutputs >> HC595_DATA_SHIFT);
+          if(Half == 0)
+            {
+              High = Nibble;
+              Half = 1;
+            }
+          else
+            {
+              Half = 0;
+              Hd44780Model_Latch((gOutputs & LCD_HC595_RS) != 0,
+               (uint8_t)((High << 4) | Nibble));
+              Bytes++;
+            }
+        }
+
+      gOutputs = Frames[i];
+    }
+
+  return Bytes;
+}
+
+int
+main(void)
+{
+  const SpiLoopbackStats_t* const Stats = SpiLoopback_GetStats();
+  uint8_t Frames[SPI_LOOPBACK_SIZE];
+  uint32_t Update;
+  uint32_t Shifted;
+  uint32_t Cursor;
+  uint8_t Bytes = 0;
+  uint16_t Size;
+
+  LcdDisplay_Init(gConfig);
+  for(Update = 0; Update < HC595_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+  Size = SpiLoopback_Read(Frames, sizeof(Frames));
+  gOutputs = Frames[Size - 1];
+  SpiLoopback_Reset();
+  Hd44780Model_Reset();
+
+  //the cursor command skips its first setup frame if the outputs hold it
+  //since the initialization
+  Cursor = 5 + (gOutputs != ((HC595_CURSOR >> 4) << HC595_DATA_SHIFT));
+
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)HC595_TEXT,
+   HC595_TEXT_SIZE, 0x00);
+
+  for(Update = 0; Update < 1 + HC595_TEXT_SIZE; Update++)
+    {
+      Shifted = Stats->Bytes;
+      (void)LcdDisplay_Update();
+      Shifted = Stats->Bytes - Shifted;
+      Bytes += Hc595_Decode();
+
+      //the first character sets its nibbles and RS, the next ones are held
+      //by the outputs: no setup frame
+      Hc595_Check(Shifted == ((Update == 0) ? Cursor : (Update == 1) ? 6 : 5),
+       "the latch frames of a burst");
+    }
+
+  printf("%u bytes in %u bursts of %u frames\n", (unsigned)Bytes,
+   (unsigned)Stats->Bursts, (unsigned)Stats->Bytes);
+  Hc595_Check(Stats->Bursts == 1 + HC595_TEXT_SIZE &&
+   Stats->LastChannel == HC595_CHANNEL && Bytes == 1 + HC595_TEXT_SIZE,
+   "a burst of one byte per update");
+  Hc595_Check(Stats->Bytes == Cursor + 6 + (HC595_TEXT_SIZE - 1) * 5,
+   "the bytes on the wire");
+  Hc595_Check(Hd44780Model_Match(0x40, HC595_TEXT), "the text latched");
+
+  Hc595_Check(LcdDisplay_Update() == 0 &&
+   Stats->Bursts == 1 + HC595_TEXT_SIZE, "no burst once idle");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
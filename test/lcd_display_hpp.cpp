@@ -0,0 +1,113 @@
+/**
+ * @file lcd_display_hpp.cpp
+ * @author Mohamed Hassanin
+ * @brief Host check of the C++17 configuration layer. A panel is checked at
+ * compile time, then its configuration and port transport drive the C
+ * module: the text must reach the DDRAM addresses of the location table of
+ * the panel, and the transport must leave the other bits of the port alone.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdio>
+#include "lcd_display.hpp"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HPP_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define HPP_PORT_OTHERS 0xC0 /**< the bits of the port not owned by the lcd */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief a 16x1 panel: its two halves are two DDRAM runs
+ */
+constexpr lcd::PanelSpec Main =
+  {LCD_DISPLAY_0, 16, 1, PORTA_1, PORTA_0, PORTA_0,
+   {PORTA_2, PORTA_3, PORTA_4, PORTA_5}, LCD_ROM_A00};
+
+using MainPanel = lcd::Panel<Main>;
+using MainPort = lcd::PortTransport<Main>;
+
+static_assert(MainPanel::Cells == 16 && MainPanel::Controllers == 1);
+static_assert(MainPanel::Location(0, 7) == 0x07 &&
+              MainPanel::Location(0, 8) == 0x40);
+static_assert(MainPort::Nibble[0x0F] == 0x3C && MainPort::Mask == 0x3F);
+
+static const LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX] =
+{
+  MainPanel::Config(&MainPort::Transport)
+};
+
+/**
+ * @brief the port register the panel is wired to
+ */
+static uint8_t gPort = HPP_PORT_OTHERS;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Hpp_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Hpp_Flush(void)
+{
+  for(uint32_t Update = 0; Update < HPP_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+int
+main(void)
+{
+  static const char Text[] = "Hello, 16x1 lcd!";
+  LcdDisplaySnapshot_t Snapshot;
+  int Failed = 0;
+
+  MainPort::Bind(&gPort);
+  DioStub_SetPort(&gPort);
+  LcdDisplay_Init(gConfig);
+  Hpp_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, nullptr);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0,
+   reinterpret_cast<const uint8_t*>(Text), 16, nullptr);
+  Hpp_Flush();
+
+  if(!(LcdDisplay_Snapshot(LCD_DISPLAY_0, &Snapshot) == 1 &&
+       Snapshot.Width == 16 && Snapshot.Height == 1))
+    {
+      std::printf("FAILED: the size of the panel\n");
+      return 1;
+    }
+
+  for(uint8_t Col = 0; Col < 16; Col++)
+    {
+      if(!(Snapshot.Text[Col] == uint8_t(Text[Col]) &&
+           Hd44780Model_Get()->Ddram[MainPanel::Location(0, Col)] ==
+           uint8_t(Text[Col])))
+        {
+          std::printf("FAILED: the text at column %u\n", unsigned(Col));
+          Failed = 1;
+        }
+    }
+
+  if((gPort & ~MainPort::Mask) != HPP_PORT_OTHERS)
+    {
+      std::printf("FAILED: the other bits of the port\n");
+      Failed = 1;
+    }
+
+  return Failed;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,137 @@
+/**
+ * @file lcd_display_idle.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the idle awareness. LcdDisplay_Update must report a
+ * display while it has bytes to send and stop as soon as they are on the
+ * display, an idle display must cost no bus traffic, and LcdDisplay_HasWork
+ * must tell the scheduler when the updates can sleep.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IDLE_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define IDLE_UPDATES 100 /**< the updates of an idle display */
+#define IDLE_TEXT "idle" /**< the text of the check */
+#define IDLE_TEXT_SIZE 4 /**< the characters of IDLE_TEXT */
+#define IDLE_DISPLAY_0 ((uint32_t)1 << LCD_DISPLAY_0) /**< the pending bit */
+#define IDLE_PERIOD 1000 /**< the updates per frame of the animation */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+
+/**
+ * @brief the frames of an animated character
+ */
+static const uint8_t gBlink[2 * 8] =
+{
+  0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Idle_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Idle_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Idle_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Idle_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < IDLE_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+int
+main(void)
+{
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  uint32_t Update;
+  uint32_t Pending = 0;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Idle_Check(LcdDisplay_HasWork() == 1, "work after the initialization");
+  Idle_Flush();
+  Idle_Check(LcdDisplay_HasWork() == 0, "no work once initialized");
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  //an idle display: no pending bit and no bus traffic
+  for(Update = 0; Update < IDLE_UPDATES; Update++)
+    {
+      Pending |= LcdDisplay_Update();
+    }
+  Idle_Check(Pending == 0 && Model->Commands == 0 && Model->Chars == 0,
+   "an idle display costs nothing");
+
+  //a write: pending until its last byte is on the display, not longer
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)IDLE_TEXT,
+   IDLE_TEXT_SIZE, 0x00);
+  Idle_Check(LcdDisplay_HasWork() == 1, "work after a write");
+  for(Update = 0; Update < IDLE_UPDATES_MAX; Update++)
+    {
+      Pending = LcdDisplay_Update();
+      Idle_Check(Pending == 0 || Pending == IDLE_DISPLAY_0,
+       "the pending bit of the display");
+      Idle_Check((Pending == 0) ==
+       (LcdDisplay_GetPending(LCD_DISPLAY_0) == 0),
+       "pending while bytes are left");
+      if(Pending == 0) break;
+    }
+  printf("%u bytes in %u updates\n",
+   (unsigned)(Model->Commands + Model->Chars), (unsigned)(Update + 1));
+  Idle_Check(Update + 1 == 1 + IDLE_TEXT_SIZE &&
+   Hd44780Model_Match(0, IDLE_TEXT), "a byte per update");
+  Idle_Check(LcdDisplay_HasWork() == 0, "no work once flushed");
+
+  //an animation keeps the updates going without a pending bit between 
+  //two frames
+  (void)LcdDisplay_Animate(LCD_DISPLAY_0, 0, gBlink, 2, IDLE_PERIOD);
+  Idle_Flush();
+  Idle_Check(LcdDisplay_HasWork() == 1 && LcdDisplay_Update() == 0,
+   "an animation has work but nothing pending");
+  (void)LcdDisplay_Animate(LCD_DISPLAY_0, 0, 0x00, 0, 0);
+  Idle_Flush();
+  Idle_Check(LcdDisplay_HasWork() == 0, "no work once the animation stops");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
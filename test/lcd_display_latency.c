@@ -0,0 +1,135 @@
+/**
+ * @file lcd_display_latency.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the latency measurement. A write of every kind is
+ * timestamped against a tick source that counts the updates; once the
+ * display is flushed each of them must be in the histogram, which is dumped
+ * for a look at the spread.
+ * @version 0.1
+ * @date 2021-04-23
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LATENCY_WRITES 7 /**< the timestamped writes of the check */
+#define LATENCY_UPDATES_MAX 10000 /**< the updates to flush the display */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the ticks: one per update
+ */
+static uint32_t gNow;
+
+/**
+ * @brief a custom character
+ */
+static const uint8_t gBell[7] = {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04};
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Latency_Ticks()
+*//**
+* \b Description: The tick source of the check<br/>
+* @return uint32_t the updates done so far
+******************************************************************************/
+static uint32_t
+Latency_Ticks(void)
+{
+  return gNow;
+}
+
+/******************************************************************************
+* Function : Latency_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Latency_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < LATENCY_UPDATES_MAX; Update++)
+    {
+      gNow++;
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+/******************************************************************************
+* Function : Latency_Dump()
+*//**
+* \b Description: Print the histogram of a display<br/>
+* @param Latency a valid pointer to the histogram.
+* @return void
+******************************************************************************/
+static void
+Latency_Dump(const LcdDisplayLatency_t* const Latency)
+{
+  uint8_t Bucket;
+
+  printf("%u writes, max %u updates, %u dropped\n", (unsigned)Latency->Count,
+   (unsigned)Latency->Max, (unsigned)Latency->Dropped);
+
+  for(Bucket = 0; Bucket < LCD_DISPLAY_LATENCY_BUCKETS; Bucket++)
+    {
+      if(Latency->Buckets[Bucket] != 0)
+        {
+          printf("  < %6lu: %u\n", 1UL << Bucket,
+           (unsigned)Latency->Buckets[Bucket]);
+        }
+    }
+}
+
+int
+main(void)
+{
+  LcdDisplayLatency_t Latency;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Latency_Flush();
+
+  LcdDisplay_SetTickSource(Latency_Ticks);
+  LcdDisplay_ResetLatency(LCD_DISPLAY_0);
+
+  //normal lane
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"latency", 7, 0x00);
+  (void)LcdDisplay_Clear(LCD_DISPLAY_0, 0x00);
+  (void)LcdDisplay_CreateChar(LCD_DISPLAY_0, 0, gBell, 0x00);
+
+  //urgent lane
+  (void)LcdDisplay_SetUrgent(LCD_DISPLAY_0, 1, 0, (const uint8_t*)"!!", 2,
+   0x00);
+
+  //frame lane: the staged write is measured once, from the commit
+  LcdDisplay_BeginFrame(LCD_DISPLAY_0);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"frame", 5, 0x00);
+  LcdDisplay_EndFrame(LCD_DISPLAY_0, 0x00);
+  (void)LcdDisplay_SetDataAt(LCD_DISPLAY_0, 1, 4, (const uint8_t*)"at", 2,
+   0x00);
+
+  Latency_Flush();
+
+  (void)LcdDisplay_GetLatency(LCD_DISPLAY_0, &Latency);
+  Latency_Dump(&Latency);
+
+  if(!(Latency.Count == LATENCY_WRITES && Latency.Dropped == 0 &&
+       Latency.Max != 0))
+    {
+      printf("FAILED: %d writes expected\n", LATENCY_WRITES);
+      return 1;
+    }
+
+  return 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,474 @@
+/**
+ * @file lcd_display_mt_stress.c
+ * @author Mohamed Hassanin
+ * @brief Stress test of the multi-threaded host front end. Producer threads
+ * write numbered records against the flusher thread; the bytes latched by
+ * the display (decoded by the dio stub) must hold every record exactly once
+ * and in order per producer. The time the producers spend enqueueing is
+ * compared against a mutex held around each call to the display module,
+ * which is what a producer waits for without the front end: the display
+ * itself limits both runs end to end. Last, the front end must stop while a
+ * character is animated.
+ * @version 0.1
+ * @date 2021-04-22
+ */
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 200112L
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "lcd_display_mt.h"
+#include "dio_stub.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define STRESS_PRODUCERS 4 /**< the producer threads */
+#define STRESS_RECORDS 3000 /**< the records of each producer */
+#define STRESS_TEXT 8 /**< the characters of a record: producer then number */
+#define STRESS_DIGITS (STRESS_TEXT - 1) /**< the digits of the number */
+#define STRESS_COLS 10 /**< the columns between the records of 2 producers */
+#define STRESS_DDRAM_MASK 0x80 /**< a set DDRAM address command */
+#define STRESS_SPINNER_FRAMES 2 /**< the frames of the animated character */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief a record of a producer
+ */
+typedef struct
+{
+  uint8_t Row;
+  uint8_t Col;
+  uint8_t Data[STRESS_TEXT];
+} StressRecord_t;
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the next record number expected from each producer and the errors
+ */
+static uint32_t gExpected[STRESS_PRODUCERS];
+static uint32_t gErrors;
+
+/**
+ * @brief the frames of an animated character
+ */
+static const uint8_t gSpinner[STRESS_SPINNER_FRAMES * 7] =
+{
+  0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+  0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00
+};
+
+/**
+ * @brief the characters of the record being latched
+ */
+static uint8_t gText[STRESS_TEXT];
+static uint8_t gTextSize;
+static uint8_t gInRecord;
+
+/**
+ * @brief the mutex of the baseline, held around each LcdDisplay_* call
+ */
+static pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int gBaselineRunning;
+
+/**
+ * @brief the enqueue calls of each producer: their number, their total and
+ * their longest time in seconds
+ */
+static uint32_t gCalls[STRESS_PRODUCERS];
+static double gCallTime[STRESS_PRODUCERS];
+static double gCallMax[STRESS_PRODUCERS];
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Stress_Latch()
+*//**
+* \b Description: Check the records in the bytes latched by the display. A
+* record is a set DDRAM address command then its characters.<br/>
+* @param Rs 1 for a character, 0 for a command.
+* @param Byte The latched byte.
+* @return void
+******************************************************************************/
+static void
+Stress_Latch(uint8_t Rs, uint8_t Byte)
+{
+  uint32_t Number = 0;
+  uint8_t Producer;
+  uint8_t i;
+
+  if(Rs == 0)
+    {
+      gInRecord = (Byte & STRESS_DDRAM_MASK) != 0;
+      gTextSize = 0;
+      return;
+    }
+
+  if(gInRecord == 0) return;
+
+  gText[gTextSize++] = Byte;
+  if(gTextSize < STRESS_TEXT) return;
+
+  gInRecord = 0;
+  Producer = (uint8_t)(gText[0] - 'A');
+  for(i = 1; i < STRESS_TEXT; i++)
+    {
+      Number = Number * 10 + (uint32_t)(gText[i] - '0');
+    }
+
+  if(!(Producer < STRESS_PRODUCERS && Number == gExpected[Producer]))
+    {
+      gErrors++;
+      return;
+    }
+
+  gExpected[Producer]++;
+}
+
+/******************************************************************************
+* Function : Stress_Format()
+*//**
+* \b Description: Build the record of a producer<br/>
+* @param Producer The producer.
+* @param Number The record number.
+* @param Record a pointer to store the record in.
+* @return void
+******************************************************************************/
+static void
+Stress_Format(uint8_t Producer, uint32_t Number, StressRecord_t* const Record)
+{
+  uint8_t i;
+
+  Record->Row = Producer % 2;
+  Record->Col = (uint8_t)((Producer / 2) * STRESS_COLS);
+  Record->Data[0] = (uint8_t)('A' + Producer);
+  for(i = STRESS_DIGITS; i > 0; i--)
+    {
+      Record->Data[i] = (uint8_t)('0' + Number % 10);
+      Number /= 10;
+    }
+}
+
+/******************************************************************************
+* Function : Stress_Reset()
+*//**
+* \b Description: Initialize the display and the checker<br/>
+* @return void
+******************************************************************************/
+static void
+Stress_Reset(void)
+{
+  uint8_t Producer;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  while(LcdDisplay_Update() != 0);
+
+  for(Producer = 0; Producer < STRESS_PRODUCERS; Producer++)
+    {
+      gExpected[Producer] = 0;
+      gCalls[Producer] = 0;
+      gCallTime[Producer] = 0;
+      gCallMax[Producer] = 0;
+    }
+  gErrors = 0;
+  gInRecord = 0;
+  DioStub_SetLatch(Stress_Latch);
+}
+
+/******************************************************************************
+* Function : Stress_Check()
+*//**
+* \b Description: Check that every record of every producer is latched<br/>
+* @param Name The name of the run.
+* @return int 0 if it passed, 1 otherwise
+******************************************************************************/
+static int
+Stress_Check(const char* const Name)
+{
+  uint8_t Producer;
+  int Failed = gErrors != 0;
+
+  for(Producer = 0; Producer < STRESS_PRODUCERS; Producer++)
+    {
+      Failed |= gExpected[Producer] != STRESS_RECORDS;
+    }
+
+  if(Failed)
+    {
+      printf("%s: FAILED (%u records out of order)\n", Name,
+       (unsigned)gErrors);
+    }
+
+  return Failed;
+}
+
+/******************************************************************************
+* Function : Stress_Now()
+*//**
+* \b Description: Get a monotonic time in seconds<br/>
+* @return double the time
+******************************************************************************/
+static double
+Stress_Now(void)
+{
+  struct timespec Now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &Now);
+
+  return (double)Now.tv_sec + (double)Now.tv_nsec / 1e9;
+}
+
+/******************************************************************************
+* Function : Stress_Time()
+*//**
+* \b Description: Account an enqueue call of a producer<br/>
+* @param Producer The producer.
+* @param Start The time the call started at.
+* @return void
+******************************************************************************/
+static void
+Stress_Time(uint8_t Producer, double Start)
+{
+  const double Time = Stress_Now() - Start;
+
+  gCalls[Producer]++;
+  gCallTime[Producer] += Time;
+  if(Time > gCallMax[Producer])
+    {
+      gCallMax[Producer] = Time;
+    }
+}
+
+/******************************************************************************
+* Function : Stress_Report()
+*//**
+* \b Description: Print the enqueue calls of the producers<br/>
+* @param Name The name of the run.
+* @param Rate a pointer to store the enqueue calls per second of a producer.
+* @return void
+******************************************************************************/
+static void
+Stress_Report(const char* const Name, double* const Rate)
+{
+  uint32_t Calls = 0;
+  double Time = 0;
+  double Max = 0;
+  uint8_t Producer;
+
+  for(Producer = 0; Producer < STRESS_PRODUCERS; Producer++)
+    {
+      Calls += gCalls[Producer];
+      Time += gCallTime[Producer];
+      if(gCallMax[Producer] > Max)
+        {
+          Max = gCallMax[Producer];
+        }
+    }
+
+  *Rate = (double)Calls / Time;
+  printf("%s %u calls (%u refused), %.0f calls/s per producer, "
+   "mean %.0f ns, max %.0f ns\n", Name, (unsigned)Calls,
+   (unsigned)(Calls - STRESS_PRODUCERS * STRESS_RECORDS), *Rate,
+   Time / Calls * 1e9, Max * 1e9);
+}
+
+/******************************************************************************
+* Function : Stress_MtProducer()
+*//**
+* \b Description: A producer of the lock-free front end. A record rejected
+* because the queue is full is retried; every call is timed.<br/>
+* @param Arg the producer.
+* @return void* 0
+******************************************************************************/
+static void*
+Stress_MtProducer(void* Arg)
+{
+  const uint8_t Producer = (uint8_t)(size_t)Arg;
+  StressRecord_t Record;
+  uint32_t Number;
+  uint8_t Written;
+  double Start;
+
+  for(Number = 0; Number < STRESS_RECORDS; Number++)
+    {
+      Stress_Format(Producer, Number, &Record);
+      for(;;)
+        {
+          Start = Stress_Now();
+          Written = LcdDisplayMt_Write(LCD_DISPLAY_0, Record.Row, Record.Col,
+           Record.Data, STRESS_TEXT);
+          Stress_Time(Producer, Start);
+          if(Written != 0) break;
+          (void)sched_yield();
+        }
+    }
+
+  return 0x00;
+}
+
+/******************************************************************************
+* Function : Stress_BaselineProducer()
+*//**
+* \b Description: A producer of the mutex baseline. It writes a record with
+* LcdDisplay_SetDataAt, which takes all of it or nothing, holding the mutex;
+* a record that doesn't fit is retried. Every call is timed, the wait for
+* the mutex included.<br/>
+* @param Arg the producer.
+* @return void* 0
+******************************************************************************/
+static void*
+Stress_BaselineProducer(void* Arg)
+{
+  const uint8_t Producer = (uint8_t)(size_t)Arg;
+  StressRecord_t Record;
+  uint32_t Number;
+  uint8_t Written;
+  double Start;
+
+  for(Number = 0; Number < STRESS_RECORDS; Number++)
+    {
+      Stress_Format(Producer, Number, &Record);
+      for(;;)
+        {
+          Start = Stress_Now();
+          (void)pthread_mutex_lock(&gLock);
+          Written = LcdDisplay_SetDataAt(LCD_DISPLAY_0, Record.Row,
+           Record.Col, Record.Data, STRESS_TEXT, 0x00);
+          (void)pthread_mutex_unlock(&gLock);
+          Stress_Time(Producer, Start);
+          if(Written != 0) break;
+          (void)sched_yield();
+        }
+    }
+
+  return 0x00;
+}
+
+/******************************************************************************
+* Function : Stress_BaselineFlusher()
+*//**
+* \b Description: The flusher of the mutex baseline: it updates the display
+* holding the mutex, like the flusher thread of the front end with a period
+* of 0.<br/>
+* @param Arg unused.
+* @return void* 0
+******************************************************************************/
+static void*
+Stress_BaselineFlusher(void* Arg)
+{
+  uint32_t Pending;
+  int Running;
+
+  (void)Arg;
+
+  for(;;)
+    {
+      //read first: once it's 0, no record is written after the update below
+      Running = atomic_load(&gBaselineRunning);
+
+      (void)pthread_mutex_lock(&gLock);
+      Pending = LcdDisplay_Update();
+      (void)pthread_mutex_unlock(&gLock);
+
+      if(Running == 0 && Pending == 0) break;
+      (void)sched_yield();
+    }
+
+  return 0x00;
+}
+
+/******************************************************************************
+* Function : Stress_Run()
+*//**
+* \b Description: Run the producers until they enqueued all their records<br/>
+* @param Producer The producer thread.
+* @return void
+******************************************************************************/
+static void
+Stress_Run(void* (*Producer)(void*))
+{
+  pthread_t Threads[STRESS_PRODUCERS];
+  size_t i;
+
+  for(i = 0; i < STRESS_PRODUCERS; i++)
+    {
+      (void)pthread_create(&Threads[i], 0x00, Producer, (void*)i);
+    }
+
+  for(i = 0; i < STRESS_PRODUCERS; i++)
+    {
+      (void)pthread_join(Threads[i], 0x00);
+    }
+}
+
+int
+main(void)
+{
+  const double Records = (double)STRESS_PRODUCERS * STRESS_RECORDS;
+  LcdDisplayMtStats_t Stats;
+  pthread_t Flusher;
+  double MtRate;
+  double MutexRate;
+  int Failed = 0;
+
+  //lock-free front end
+  Stress_Reset();
+  if(LcdDisplayMt_Start(0) == 0)
+    {
+      printf("lock-free: FAILED to start\n");
+      return 1;
+    }
+  Stress_Run(Stress_MtProducer);
+  LcdDisplayMt_Stop();
+  LcdDisplayMt_GetStats(&Stats);
+
+  Failed |= Stress_Check("lock-free");
+  if(!(Stats.Applied == Records && Stats.Dropped == 0))
+    {
+      printf("lock-free: FAILED (%u applied, %u dropped)\n",
+       (unsigned)Stats.Applied, (unsigned)Stats.Dropped);
+      Failed = 1;
+    }
+
+  printf("%d producers x %d records, enqueue calls:\n", STRESS_PRODUCERS,
+   STRESS_RECORDS);
+  Stress_Report("lock-free:", &MtRate);
+
+  //mutex baseline
+  Stress_Reset();
+  atomic_store(&gBaselineRunning, 1);
+  (void)pthread_create(&Flusher, 0x00, Stress_BaselineFlusher, 0x00);
+  Stress_Run(Stress_BaselineProducer);
+  atomic_store(&gBaselineRunning, 0);
+  (void)pthread_join(Flusher, 0x00);
+
+  Failed |= Stress_Check("mutex");
+  Stress_Report("mutex:    ", &MutexRate);
+  printf("lock-free/mutex: %.1fx the enqueue calls per second\n",
+   MtRate / MutexRate);
+
+  //an animated character keeps the updates going, not the flusher thread:
+  //LcdDisplayMt_Stop must return
+  Stress_Reset();
+  if(LcdDisplay_Animate(LCD_DISPLAY_0, 0, gSpinner, STRESS_SPINNER_FRAMES,
+      1) == 0 || LcdDisplayMt_Start(0) == 0)
+    {
+      printf("animated: FAILED to start\n");
+      return 1;
+    }
+  LcdDisplayMt_Stop();
+  printf("animated: stopped\n");
+
+  return Failed;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,183 @@
+/**
+ * @file lcd_display_pcf8574.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the PCF8574 I2C backpack transport over the i2c stub.
+ * An update must send up to LCD_PCF8574_BURST bytes in one transaction, each
+ * byte as 6 port states less a setup state per nibble the port already 
+ * holds, and the port states must latch the bytes that were written.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "i2c_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PCF_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define PCF_ADDRESS 0x27 /**< the i2c address of the backpack */
+#define PCF_TEXT "33333333" /**< characters with the same two nibbles */
+#define PCF_TEXT_SIZE 8 /**< the characters of PCF_TEXT */
+#define PCF_CURSOR 0xC0 /**< the cursor command of the second row */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief a 16x2 display on the backpack
+ */
+static const LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX] =
+{
+  {
+    .Display = LCD_DISPLAY_0,
+    .Width = 16,
+    .Height = 2,
+    .Geometry = &LcdGeometry_16x2,
+    .Transport = &LcdTransport_Pcf8574,
+    .BusAddress = PCF_ADDRESS,
+    .Rom = LCD_ROM_A00,
+    .ScrubBudget = 0,
+    .Locations = 0x00
+  }
+};
+
+/**
+ * @brief the failed checks and the port state before the last transaction
+ */
+static uint32_t gFailed;
+static uint8_t gPort;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Pcf_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Pcf_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Pcf_Decode()
+*//**
+* \b Description: Latch the bytes of the last transaction into the model. A
+* falling edge of EN latches a nibble of the port.<br/>
+* @return uint8_t the number of bytes latched
+******************************************************************************/
+static uint8_t
+Pcf_Decode(void)
+{
+  const I2cStubStats_t* const Stats = I2cStub_GetStats();
+  uint8_t Bytes = 0;
+  uint8_t High = 0;
+  uint8_t Half = 0;
+  uint8_t Nibble;
+  uint8_t i;
+
+  for(i = 0; i < Stats->LastSize; i++)
+    {
+      if((gPort & LCD_PCF8574_EN) && !(Stats->Last[i] & LCD_PCF8574_EN))
+        {
+          Nibble = (uint8_t)(gPort >> LCD_PCF8574_DATA_SHIFT);
+          if(Half == 0)
+            {
+              High = Nibble;
+              Half = 1;
+            }
+          else
+            {
+              Half = 0;
+              Hd44780Model_Latch((gPort & LCD_PCF8574_RS) != 0,
+               (uint8_t)((High << 4) | Nibble));
+              Bytes++;
+            }
+        }
+
+      gPort = Stats->Last[i];
+    }
+
+  return Bytes;
+}
+
+/******************************************************************************
+* Function : Pcf_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Pcf_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < PCF_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+int
+main(void)
+{
+  const I2cStubStats_t* const Stats = I2cStub_GetStats();
+  uint8_t Burst;
+  uint8_t Bytes;
+
+  LcdDisplay_Init(gConfig);
+  Pcf_Flush();
+  gPort = Stats->Last[Stats->LastSize - 1];
+  I2cStub_Reset();
+  Hd44780Model_Reset();
+
+  //the cursor command skips its first setup state if the port holds it
+  //since the initialization. The first character sets its nibble and RS 
+  //once: its low nibble and the next characters skip the setup states.
+  Burst = (uint8_t)(5 + (gPort != (LCD_PCF8574_BL |
+   (PCF_CURSOR >> 4) << LCD_PCF8574_DATA_SHIFT)) + 5 +
+   (LCD_PCF8574_BURST - 2) * 4);
+
+  //the cursor command and 7 characters fill a burst, the 8th is alone
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)PCF_TEXT,
+   PCF_TEXT_SIZE, 0x00);
+
+  (void)LcdDisplay_Update();
+  Bytes = Pcf_Decode();
+  printf("burst 1: %u bytes in %u port states\n", (unsigned)Bytes,
+   (unsigned)Stats->LastSize);
+  Pcf_Check(Stats->Transactions == 1 && Stats->LastAddress == PCF_ADDRESS,
+   "one transaction to the backpack per update");
+  Pcf_Check(Bytes == LCD_PCF8574_BURST, "a full burst");
+  Pcf_Check(Stats->LastSize == Burst, "the port states of the burst");
+
+  (void)LcdDisplay_Update();
+  Bytes = Pcf_Decode();
+  printf("burst 2: %u bytes in %u port states\n", (unsigned)Bytes,
+   (unsigned)Stats->LastSize);
+  Pcf_Check(Stats->Transactions == 2 && Bytes == 1 && Stats->LastSize == 4,
+   "the last character alone");
+
+  //every transaction has its address byte on the wire
+  Pcf_Check(Stats->Bytes == (uint32_t)(Burst + 1) + (4 + 1),
+   "the bytes on the wire");
+  Pcf_Check(Hd44780Model_Match(0x40, PCF_TEXT), "the text latched");
+
+  Pcf_Check(LcdDisplay_Update() == 0 && Stats->Transactions == 2,
+   "no transaction once idle");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,184 @@
+/**
+ * @file lcd_display_region.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the text regions. A clipped region must drop the end
+ * of a long line, a wrapped one must continue it on the next line and
+ * scroll past its last line, a region must never touch the cells around it
+ * and a scroll must only send the cells that change.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "lcd_region.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define REGION_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define REGION_STATUS_WIDTH 8 /**< the columns of the clipped region */
+#define REGION_LOG_COL 10 /**< the first column of the wrapped region */
+#define REGION_LOG_WIDTH 6 /**< the columns of the wrapped region */
+#define REGION_LOG_HEIGHT 3 /**< the rows of the wrapped region */
+#define REGION_LOG_CHANGES 13 /**< the cells changed by the scroll */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the DDRAM address of each row of a 20x4 display
+ */
+static const uint8_t gRowAddress[4] = {0x00, 0x40, 0x14, 0x54};
+
+/**
+ * @brief the configuration of the display: the pins of the default one on
+ * a 20x4 panel
+ */
+static LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Region_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Region_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Region_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Region_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < REGION_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+/******************************************************************************
+* Function : Region_Match()
+*//**
+* \b Description: Check the cells of the display from a position against a
+* text<br/>
+* @param Row The row in the display.
+* @param Col The column in the display.
+* @param Text The text, 0 terminated.
+* @return int 1 if the cells hold the text, 0 otherwise
+******************************************************************************/
+static int
+Region_Match(uint8_t Row, uint8_t Col, const char* const Text)
+{
+  return Hd44780Model_Match((uint8_t)(gRowAddress[Row] + Col), Text);
+}
+
+/******************************************************************************
+* Function : Region_Write()
+*//**
+* \b Description: Write a text to a region and flush the display<br/>
+* @param Region The region.
+* @param Text The text, 0 terminated.
+* @return uint8_t how many characters are stored in the region
+******************************************************************************/
+static uint8_t
+Region_Write(LcdRegion_t* const Region, const char* const Text)
+{
+  uint8_t Stored;
+
+  Stored = LcdRegion_Write(Region, (const uint8_t*)Text,
+   (uint8_t)strlen(Text));
+  Region_Flush();
+
+  return Stored;
+}
+
+int
+main(void)
+{
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  uint8_t StatusText[REGION_STATUS_WIDTH];
+  uint8_t LogText[REGION_LOG_WIDTH * REGION_LOG_HEIGHT];
+  uint8_t OutsideText[REGION_LOG_WIDTH];
+  LcdRegion_t Status;
+  LcdRegion_t Log;
+  LcdRegion_t Outside;
+  uint32_t Chars;
+
+  gConfig[LCD_DISPLAY_0] = LcdDisplay_GetConfig()[LCD_DISPLAY_0];
+  gConfig[LCD_DISPLAY_0].Width = 20;
+  gConfig[LCD_DISPLAY_0].Height = 4;
+  gConfig[LCD_DISPLAY_0].Geometry = &LcdGeometry_20x4;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(gConfig);
+  Region_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  Region_Check(LcdRegion_Create(&Status, LCD_DISPLAY_0, 0, 0,
+   REGION_STATUS_WIDTH, 1, LCD_REGION_CLIP, StatusText) == 1 &&
+   LcdRegion_Create(&Log, LCD_DISPLAY_0, 1, REGION_LOG_COL, REGION_LOG_WIDTH,
+   REGION_LOG_HEIGHT, LCD_REGION_WRAP | LCD_REGION_SCROLL, LogText) == 1,
+   "the regions created");
+  Region_Check(LcdRegion_Create(&Outside, LCD_DISPLAY_0, 0, 20 -
+   REGION_LOG_WIDTH + 1, REGION_LOG_WIDTH, 1, LCD_REGION_CLIP,
+   OutsideText) == 0, "no region past the edge of the display");
+
+  //a clipped line keeps the width of its region
+  Region_Check(Region_Write(&Status, "temperature") == REGION_STATUS_WIDTH,
+   "the clipped line stored");
+  Region_Check(Region_Write(&Status, "!") == 0, "nothing past the clip");
+  Region_Check(Region_Match(0, 0, "temperat") &&
+   Model->Ddram[REGION_STATUS_WIDTH] == HD44780_MODEL_BLANK,
+   "the clipped line shown");
+
+  //a wrapped line goes on at the next line of the region
+  (void)Region_Write(&Log, "abcdefghij\n123");
+  Region_Check(Region_Match(1, REGION_LOG_COL, "abcdef") &&
+   Region_Match(2, REGION_LOG_COL, "ghij  ") &&
+   Region_Match(3, REGION_LOG_COL, "123   "), "the wrapped lines shown");
+
+  //past the last line the region scrolls: only the changed cells are sent
+  Chars = Model->Chars;
+  (void)Region_Write(&Log, "\n456");
+  printf("scroll: %u cells sent\n", (unsigned)(Model->Chars - Chars));
+  Region_Check(Region_Match(1, REGION_LOG_COL, "ghij  ") &&
+   Region_Match(2, REGION_LOG_COL, "123   ") &&
+   Region_Match(3, REGION_LOG_COL, "456   "), "the scrolled lines shown");
+  Region_Check(Model->Chars - Chars == REGION_LOG_CHANGES,
+   "only the changed cells sent");
+
+  //the cells around the regions are never touched
+  Region_Check(Model->Ddram[gRowAddress[1] + REGION_LOG_COL - 1] ==
+   HD44780_MODEL_BLANK && Model->Ddram[gRowAddress[1] + REGION_LOG_COL +
+   REGION_LOG_WIDTH] == HD44780_MODEL_BLANK && Region_Match(0, 0, "temperat"),
+   "the cells around the regions");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,185 @@
+/**
+ * @file lcd_display_scrub.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the DDRAM scrub. The idle updates of a display with a
+ * ScrubBudget read its DDRAM back over the R/W channel: a clean display must
+ * not be rewritten, a corrupted cell must be repaired, and an address
+ * counter that moved behind the back of the driver must be taken for a
+ * mode loss and recovered from, with the text intact afterwards.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SCRUB_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define SCRUB_BUDGET 4 /**< the scrub steps per update */
+#define SCRUB_PASSES 3 /**< the updates of a pass are counted this often */
+#define SCRUB_ROW_0 "scrubbed display" /**< the text of the first row */
+#define SCRUB_ROW_1 "row 1 read back" /**< the text of the second row */
+#define SCRUB_LINE_1 0x40 /**< the DDRAM address of the second row */
+#define SCRUB_CELL 5 /**< the corrupted cell of the first row */
+#define SCRUB_GLITCH '#' /**< the character of the corrupted cell */
+#define SCRUB_LOST 0x20 /**< the address counter after a mode loss */
+#define SCRUB_SET_DDRAM 0x80 /**< the set DDRAM address command */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the configuration of the display: the pins of the default one with
+ * an R/W channel and a scrub budget
+ */
+static LcdDisplayConfig_t gConfig[LCD_DISPLAY_MAX];
+
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Scrub_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Scrub_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Scrub_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Scrub_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < SCRUB_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+/******************************************************************************
+* Function : Scrub_Run()
+*//**
+* \b Description: Run the idle updates of a few scrub passes over the whole
+* display. A cell takes up to 3 steps: the address, the read and the
+* repair.<br/>
+* @return void
+******************************************************************************/
+static void
+Scrub_Run(void)
+{
+  const uint32_t Cells = (uint32_t)gConfig[LCD_DISPLAY_0].Width *
+   gConfig[LCD_DISPLAY_0].Height;
+  uint32_t Update;
+
+  for(Update = 0; Update < SCRUB_PASSES * 3 * Cells / SCRUB_BUDGET; Update++)
+    {
+      (void)LcdDisplay_Update();
+    }
+}
+
+/******************************************************************************
+* Function : Scrub_Poke()
+*//**
+* \b Description: Change a cell of the controller behind the back of the
+* driver. The address counter is put back.<br/>
+* @param Address The DDRAM address of the cell.
+* @param Byte The character.
+* @return void
+******************************************************************************/
+static void
+Scrub_Poke(uint8_t Address, uint8_t Byte)
+{
+  const uint8_t Counter = Hd44780Model_Get()->Address;
+
+  Hd44780Model_Latch(0, SCRUB_SET_DDRAM | Address);
+  Hd44780Model_Latch(1, Byte);
+  Hd44780Model_Latch(0, SCRUB_SET_DDRAM | Counter);
+}
+
+int
+main(void)
+{
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  uint32_t Chars;
+
+  gConfig[LCD_DISPLAY_0] = LcdDisplay_GetConfig()[LCD_DISPLAY_0];
+  gConfig[LCD_DISPLAY_0].Rw = PORTA_6;
+  gConfig[LCD_DISPLAY_0].ScrubBudget = SCRUB_BUDGET;
+
+  DioStub_SetConfig(gConfig);
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(gConfig);
+  Scrub_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+  DioStub_SetRead(Hd44780Model_Read);
+  Scrub_Check(LcdDisplay_HasWork() == 1, "a scrubbed display has work");
+
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)SCRUB_ROW_0,
+   sizeof(SCRUB_ROW_0) - 1, 0x00);
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)SCRUB_ROW_1,
+   sizeof(SCRUB_ROW_1) - 1, 0x00);
+  Scrub_Flush();
+
+  //a clean display is read back but never rewritten
+  Chars = Model->Chars;
+  Scrub_Run();
+  Scrub_Check(Model->Chars == Chars && Hd44780Model_Match(0, SCRUB_ROW_0) &&
+   Hd44780Model_Match(SCRUB_LINE_1, SCRUB_ROW_1), "a clean display kept");
+
+  //a corrupted cell is rewritten from the DDRAM shadow
+  Scrub_Poke(SCRUB_CELL, SCRUB_GLITCH);
+  Chars = Model->Chars;
+  Scrub_Run();
+  printf("repair: %u characters rewritten\n",
+   (unsigned)(Model->Chars - Chars));
+  Scrub_Check(Model->Chars == Chars + 1 && Hd44780Model_Match(0, SCRUB_ROW_0),
+   "the corrupted cell repaired");
+
+  //an address counter that moved is a mode loss: the controller is
+  //initialized again and the corrupted cells repaired
+  Scrub_Poke(SCRUB_LINE_1, SCRUB_GLITCH);
+  Hd44780Model_Latch(0, SCRUB_SET_DDRAM | SCRUB_LOST);
+  Scrub_Run();
+  Scrub_Check(Hd44780Model_Match(0, SCRUB_ROW_0) &&
+   Hd44780Model_Match(SCRUB_LINE_1, SCRUB_ROW_1),
+   "the display recovered from a mode loss");
+
+  //the normal writes go on where they were
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"!", 1, 0x00);
+  Scrub_Flush();
+  Scrub_Check(Model->Ddram[SCRUB_LINE_1 + sizeof(SCRUB_ROW_1) - 1] == '!',
+   "the cursor of the normal writes restored");
+
+  DioStub_SetRead(0x00);
+  DioStub_SetConfig(0x00);
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
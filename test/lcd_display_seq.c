@@ -0,0 +1,135 @@
+/**
+ * @file lcd_display_seq.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the sequence numbers given by the writes. A write
+ * staged inside a frame must not be complete before the frame is committed
+ * and flushed, and a write that isn't enqueued must not give a number.
+ * @version 0.1
+ * @date 2021-04-24
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SEQ_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define SEQ_UNSET 0xA5A5A5A5U /**< a sequence number no write gives */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the failed checks and the completion callbacks
+ */
+static uint32_t gFailed;
+static uint32_t gCalls;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Seq_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Seq_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Seq_Done()
+*//**
+* \b Description: The completion callback of the check<br/>
+* @param Display The display.
+* @param Seq The complete sequence number.
+* @return void
+******************************************************************************/
+static void
+Seq_Done(LcdDisplay_t Display, LcdDisplaySeq_t Seq)
+{
+  (void)Display;
+  (void)Seq;
+  gCalls++;
+}
+
+/******************************************************************************
+* Function : Seq_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Seq_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < SEQ_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+int
+main(void)
+{
+  LcdDisplaySeq_t Cursor;
+  LcdDisplaySeq_t Text;
+  LcdDisplaySeq_t Frame;
+  LcdDisplaySeq_t Cleared = SEQ_UNSET;
+  uint32_t Update;
+  uint8_t Written;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Seq_Flush();
+
+  //the staged writes wait for the commit, whatever the updates
+  LcdDisplay_BeginFrame(LCD_DISPLAY_0);
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 2, &Cursor);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"staged", 6, &Text);
+  Seq_Check(LcdDisplay_OnComplete(LCD_DISPLAY_0, Text, Seq_Done) == 1,
+   "register the callback");
+  Seq_Flush();
+  Seq_Check(LcdDisplay_IsComplete(LCD_DISPLAY_0, Cursor) == 0 &&
+   LcdDisplay_IsComplete(LCD_DISPLAY_0, Text) == 0 && gCalls == 0,
+   "staged writes incomplete before EndFrame");
+
+  LcdDisplay_EndFrame(LCD_DISPLAY_0, &Frame);
+  Seq_Check(Frame == Text, "staged writes complete with their frame");
+  Seq_Check(LcdDisplay_IsComplete(LCD_DISPLAY_0, Text) == 0,
+   "staged writes incomplete before the frame is flushed");
+
+  for(Update = 0; Update < SEQ_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_IsComplete(LCD_DISPLAY_0, Text) == 1) break;
+      (void)LcdDisplay_Update();
+    }
+  Seq_Check(LcdDisplay_IsComplete(LCD_DISPLAY_0, Text) == 1 && gCalls == 1,
+   "staged writes complete once the frame is flushed");
+
+  //a clear that doesn't fit gives no number
+  (void)LcdDisplay_EndFrames(LCD_DISPLAY_0, 0x00);
+  do
+    {
+      Written = LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"x", 1,
+       0x00);
+    }
+  while(Written != 0);
+  Seq_Check(LcdDisplay_Clear(LCD_DISPLAY_0, &Cleared) == 0 &&
+   Cleared == SEQ_UNSET, "no number from a refused clear");
+  Seq_Flush();
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,165 @@
+/**
+ * @file lcd_display_snapshot.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the snapshots. A snapshot must hold what the display
+ * holds (the bytes that reached it, not the pending ones) and the change
+ * counter must advance with every cell or CGRAM row that changes, and only
+ * then.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SNAP_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define SNAP_LINE_1 0x40 /**< the DDRAM address of the second row */
+#define SNAP_GLYPH_ROWS 7 /**< the rows of a custom character */
+#define SNAP_GLYPH_CHANGES 6 /**< the rows of gBell that aren't blank */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief a custom character
+ */
+static const uint8_t gBell[SNAP_GLYPH_ROWS] =
+{
+  0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04
+};
+
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Snap_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Snap_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Snap_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Snap_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < SNAP_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+/******************************************************************************
+* Function : Snap_Match()
+*//**
+* \b Description: Check a snapshot against the controller model: every cell
+* and the CGRAM<br/>
+* @param Snapshot The snapshot.
+* @return int 1 if the snapshot holds what the controller holds, 0 otherwise
+******************************************************************************/
+static int
+Snap_Match(const LcdDisplaySnapshot_t* const Snapshot)
+{
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  uint8_t Row;
+  uint8_t Col;
+
+  for(Row = 0; Row < Snapshot->Height; Row++)
+    {
+      for(Col = 0; Col < Snapshot->Width; Col++)
+        {
+          if(Snapshot->Text[Row * Snapshot->Width + Col] !=
+             Model->Ddram[Row * SNAP_LINE_1 + Col])
+            {
+              return 0;
+            }
+        }
+    }
+
+  return memcmp(Snapshot->Cgram[0], Model->Cgram, HD44780_MODEL_CGRAM) == 0;
+}
+
+int
+main(void)
+{
+  LcdDisplaySnapshot_t Snapshot;
+  uint32_t Changes;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Snap_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  Changes = LcdDisplay_GetChanges(LCD_DISPLAY_0);
+  Snap_Check(LcdDisplay_Snapshot(LCD_DISPLAY_0, &Snapshot) == 1 &&
+   Snapshot.Changes == Changes && Snap_Match(&Snapshot), "a blank display");
+
+  //the pending bytes aren't on the display yet
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 2, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"snap", 4, 0x00);
+  (void)LcdDisplay_Snapshot(LCD_DISPLAY_0, &Snapshot);
+  Snap_Check(Snapshot.Changes == Changes && Snap_Match(&Snapshot),
+   "the pending bytes left out");
+
+  //the cursor command then the first character
+  (void)LcdDisplay_Update();
+  (void)LcdDisplay_Update();
+  (void)LcdDisplay_Snapshot(LCD_DISPLAY_0, &Snapshot);
+  Snap_Check(Snapshot.Changes == Changes + 1 && Snap_Match(&Snapshot) &&
+   Snapshot.Text[Snapshot.Width + 2] == 's', "the first character shown");
+
+  Snap_Flush();
+  (void)LcdDisplay_Snapshot(LCD_DISPLAY_0, &Snapshot);
+  Snap_Check(Snapshot.Changes == Changes + 4 &&
+   LcdDisplay_GetChanges(LCD_DISPLAY_0) == Snapshot.Changes &&
+   Snap_Match(&Snapshot), "the text shown");
+
+  //the same text again changes no cell
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 1, 2, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"snap", 4, 0x00);
+  Snap_Flush();
+  Snap_Check(LcdDisplay_GetChanges(LCD_DISPLAY_0) == Changes + 4,
+   "no change without a changed cell");
+
+  //a custom character changes the CGRAM rows that differ: the blank row
+  //was blank already
+  Snap_Check(LcdDisplay_CreateChar(LCD_DISPLAY_0, 1, gBell, 0x00) == 1,
+   "the custom character created");
+  Snap_Flush();
+  (void)LcdDisplay_Snapshot(LCD_DISPLAY_0, &Snapshot);
+  Snap_Check(Snapshot.Changes == Changes + 4 + SNAP_GLYPH_CHANGES &&
+   Snap_Match(&Snapshot) &&
+   memcmp(&Snapshot.Cgram[0][8], gBell, SNAP_GLYPH_ROWS) == 0,
+   "the custom character in the snapshot");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,117 @@
+/**
+ * @file lcd_display_urgent.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the urgent lane. A message must preempt the text
+ * queued in the normal buffer within its bound, the address counter of the
+ * normal buffer must be restored after it, and a message must be clipped
+ * at the end of its row.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define URGENT_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define URGENT_SENT 4 /**< the updates given to the normal buffer first */
+#define URGENT_LINE_1 0x40 /**< the DDRAM address of the second row */
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Urgent_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Urgent_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Urgent_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Urgent_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < URGENT_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+int
+main(void)
+{
+  LcdDisplaySeq_t Urgent;
+  uint32_t Updates;
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Urgent_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  //the message preempts the text: its cursor command then its characters
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  (void)LcdDisplay_SetData(LCD_DISPLAY_0, (const uint8_t*)"ABCDEFGHIJ", 10,
+   0x00);
+  for(Updates = 0; Updates < URGENT_SENT; Updates++)
+    {
+      (void)LcdDisplay_Update();
+    }
+
+  Urgent_Check(LcdDisplay_SetUrgent(LCD_DISPLAY_0, 1, 0,
+   (const uint8_t*)"!!", 2, &Urgent) == 1, "enqueue the message");
+  for(Updates = 0; Updates < URGENT_UPDATES_MAX; Updates++)
+    {
+      if(LcdDisplay_IsComplete(LCD_DISPLAY_0, Urgent) == 1) break;
+      (void)LcdDisplay_Update();
+    }
+  printf("message on the display after %u updates\n", (unsigned)Updates);
+  Urgent_Check(Updates <= 2 + 1, "the message within 2 characters + 1 run");
+  Urgent_Check(Hd44780Model_Match(URGENT_LINE_1, "!!") &&
+   !Hd44780Model_Match(0, "ABCDEFGHIJ"), "the message before the text");
+
+  //the text goes on where it was preempted
+  Urgent_Flush();
+  Urgent_Check(Hd44780Model_Match(0, "ABCDEFGHIJ") &&
+   Hd44780Model_Match(URGENT_LINE_1, "!!  "),
+   "the address counter restored after the message");
+
+  //the message is clipped at the end of the row
+  Urgent_Check(LcdDisplay_SetUrgent(LCD_DISPLAY_0, 1, 18,
+   (const uint8_t*)"WXYZ", 4, 0x00) == 1, "enqueue a long message");
+  Urgent_Flush();
+  Urgent_Check(Hd44780Model_Match(URGENT_LINE_1 + 18, "WX  "),
+   "the message clipped at the end of the row");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,189 @@
+/**
+ * @file lcd_display_utf8.c
+ * @author Mohamed Hassanin
+ * @brief Host check of the UTF-8 text. The decoder must refuse the overlong
+ * encodings, the surrogates and the truncated sequences, the map must give
+ * the codes of the A00 and A02 datasheets (two codes for a voiced kana) and
+ * LcdDisplay_SetUtf8 must latch them on the display.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lcd_display.h"
+#include "dio_stub.h"
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define UTF8_UPDATES_MAX 10000 /**< the updates to flush the display */
+#define UTF8_SEQ_MAX 4 /**< the bytes of the longest sequence */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief a sequence and the code point it decodes to
+ */
+typedef struct
+{
+  const char* Name; /**< the name of the case */
+  uint8_t Text[UTF8_SEQ_MAX]; /**< the sequence */
+  uint8_t Size; /**< the bytes of the sequence */
+  uint8_t Used; /**< the bytes the decoder must use */
+  uint32_t CodePoint; /**< the code point, LCD_CHARSET_INVALID if refused */
+} Utf8Decode_t;
+
+/**
+ * @brief a code point and its codes in a character ROM
+ */
+typedef struct
+{
+  LcdRom_t Rom; /**< the character ROM */
+  uint32_t CodePoint; /**< the code point */
+  uint8_t Count; /**< the number of codes, 0 if the ROM lacks it */
+  uint8_t Codes[LCD_CHARSET_CODES_MAX]; /**< the codes */
+} Utf8Map_t;
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the decoder cases
+ */
+static const Utf8Decode_t gDecodes[] =
+{
+  {"ascii", {0x41}, 1, 1, 0x41},
+  {"2 bytes", {0xC2, 0xB0}, 2, 2, 0xB0},
+  {"3 bytes", {0xE3, 0x82, 0xAC}, 3, 3, 0x30AC},
+  {"4 bytes", {0xF0, 0x9F, 0x98, 0x80}, 4, 4, 0x1F600},
+  {"overlong 2 bytes", {0xC0, 0xAF}, 2, 2, LCD_CHARSET_INVALID},
+  {"overlong 3 bytes", {0xE0, 0x80, 0xAF}, 3, 3, LCD_CHARSET_INVALID},
+  {"overlong 4 bytes", {0xF0, 0x82, 0x82, 0xAC}, 4, 4, LCD_CHARSET_INVALID},
+  {"high surrogate", {0xED, 0xA0, 0x80}, 3, 3, LCD_CHARSET_INVALID},
+  {"low surrogate", {0xED, 0xBF, 0xBF}, 3, 3, LCD_CHARSET_INVALID},
+  {"above U+10FFFF", {0xF4, 0x90, 0x80, 0x80}, 4, 4, LCD_CHARSET_INVALID},
+  {"lone continuation", {0x80}, 1, 1, LCD_CHARSET_INVALID},
+  {"truncated", {0xE3, 0x82}, 2, 2, LCD_CHARSET_INVALID},
+  {"interrupted", {0xE3, 0x41, 0x42}, 3, 1, LCD_CHARSET_INVALID}
+};
+
+/**
+ * @brief the map cases, from the character tables of the datasheet
+ */
+static const Utf8Map_t gMaps[] =
+{
+  {LCD_ROM_A00, 0xB0, 1, {0xDF}}, /* degree sign */
+  {LCD_ROM_A00, 0xB5, 1, {0xE4}}, /* micro sign */
+  {LCD_ROM_A00, 0xE4, 1, {0xE1}}, /* a umlaut */
+  {LCD_ROM_A00, 0xDF, 1, {0xE2}}, /* sharp s */
+  {LCD_ROM_A00, 0x30A2, 1, {0xB1}}, /* katakana a */
+  {LCD_ROM_A00, 0x30AC, 2, {0xB6, 0xDE}}, /* ka + voiced sound mark */
+  {LCD_ROM_A00, 0x30D1, 2, {0xCA, 0xDF}}, /* ha + semi-voiced mark */
+  {LCD_ROM_A00, 0x304C, 2, {0xB6, 0xDE}}, /* hiragana ga as katakana */
+  {LCD_ROM_A00, 0xFF71, 1, {0xB1}}, /* halfwidth katakana a */
+  {LCD_ROM_A00, 0x1F600, 0, {0}},
+  {LCD_ROM_A02, 0xB0, 1, {0xB0}},
+  {LCD_ROM_A02, 0xE4, 1, {0xE4}},
+  {LCD_ROM_A02, 0x30AC, 0, {0}}
+};
+
+/**
+ * @brief the failed checks
+ */
+static uint32_t gFailed;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Utf8_Check()
+*//**
+* \b Description: Report a failed check<br/>
+* @param Passed 1 if the check passed.
+* @param Name The name of the check.
+* @return void
+******************************************************************************/
+static void
+Utf8_Check(int Passed, const char* const Name)
+{
+  if(!Passed)
+    {
+      printf("FAILED: %s\n", Name);
+      gFailed++;
+    }
+}
+
+/******************************************************************************
+* Function : Utf8_Flush()
+*//**
+* \b Description: Update the display until it has nothing left to send<br/>
+* @return void
+******************************************************************************/
+static void
+Utf8_Flush(void)
+{
+  uint32_t Update;
+
+  for(Update = 0; Update < UTF8_UPDATES_MAX; Update++)
+    {
+      if(LcdDisplay_Update() == 0) break;
+    }
+}
+
+int
+main(void)
+{
+  //"25°C ガ" then an overlong '/': the kana takes two cells
+  static const uint8_t Text[] =
+   {'2', '5', 0xC2, 0xB0, 'C', ' ', 0xE3, 0x82, 0xAC, 0xC0, 0xAF};
+  static const uint8_t Cells[] =
+   {'2', '5', 0xDF, 'C', ' ', 0xB6, 0xDE, '?'};
+  const Hd44780Model_t* const Model = Hd44780Model_Get();
+  uint8_t Codes[LCD_CHARSET_CODES_MAX];
+  uint32_t CodePoint;
+  uint8_t Count;
+  uint8_t Used;
+  uint8_t i;
+
+  for(i = 0; i < sizeof(gDecodes) / sizeof(gDecodes[0]); i++)
+    {
+      Used = LcdCharset_Decode(gDecodes[i].Text, gDecodes[i].Size,
+       &CodePoint);
+      Utf8_Check(Used == gDecodes[i].Used &&
+       CodePoint == gDecodes[i].CodePoint, gDecodes[i].Name);
+    }
+
+  for(i = 0; i < sizeof(gMaps) / sizeof(gMaps[0]); i++)
+    {
+      Count = LcdCharset_Map(gMaps[i].Rom, gMaps[i].CodePoint, Codes);
+      if(!(Count == gMaps[i].Count &&
+           (Count < 1 || Codes[0] == gMaps[i].Codes[0]) &&
+           (Count < 2 || Codes[1] == gMaps[i].Codes[1])))
+        {
+          printf("U+%04X on rom %u: %u codes\n",
+           (unsigned)gMaps[i].CodePoint, (unsigned)gMaps[i].Rom,
+           (unsigned)Count);
+          Utf8_Check(0, "the codes of a code point");
+        }
+    }
+
+  DioStub_SetLatch(0x00);
+  LcdDisplay_Init(LcdDisplay_GetConfig());
+  Utf8_Flush();
+  Hd44780Model_Reset();
+  DioStub_SetLatch(Hd44780Model_Latch);
+
+  (void)LcdDisplay_SetCursor(LCD_DISPLAY_0, 0, 0, 0x00);
+  Utf8_Check(LcdDisplay_SetUtf8(LCD_DISPLAY_0, Text, sizeof(Text), 0x00) ==
+   sizeof(Text), "the whole text sent");
+  Utf8_Flush();
+
+  for(i = 0; i < sizeof(Cells); i++)
+    {
+      Utf8_Check(Model->Ddram[i] == Cells[i], "the codes latched");
+    }
+  Utf8_Check(Model->Chars == sizeof(Cells), "a cell per code");
+
+  return gFailed != 0;
+}
+/*****************************End of File ************************************/
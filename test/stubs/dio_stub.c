@@ -0,0 +1,223 @@
+/**
+ * @file dio_stub.c
+ * @author Mohamed Hassanin
+ * @brief A host stub of the dio interface. It decodes the 4-bit HD44780 bus
+ * driven by the dio transport of LCD_DISPLAY_0 and reports every latched 
+ * byte. A port register can stand for the first port, so the transports 
+ * writing whole ports are decoded too. When the display has an R/W channel,
+ * the reads are answered by a callback.
+ * @version 0.1
+ * @date 2021-04-22
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "dio_stub.h"
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the state of each channel
+ */
+static DioState_t gPins[DIO_CHANNEL_MAX];
+
+/**
+ * @brief the high nibble of the byte being latched and 1 once it's latched
+ */
+static uint8_t gHigh;
+static uint8_t gHalf;
+
+/**
+ * @brief the byte being read and 1 once its high nibble is on the bus
+ */
+static uint8_t gRead;
+static uint8_t gReadHalf;
+
+/**
+ * @brief the callbacks of the latched and the read bytes
+ */
+static DioStubLatch_t gLatch;
+static DioStubRead_t gReader;
+
+/**
+ * @brief the configuration of the decoded display, 0 for the default one
+ */
+static const LcdDisplayConfig_t* gConfig;
+
+/**
+ * @brief the register standing for the first port, 0 if there's none
+ */
+static volatile uint8_t* gPort;
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : DioStub_SetConfig()
+*//**
+* \b Description: Set the configuration whose channels are decoded<br/>
+* @param Config The configuration of the display, 0 for the default one
+* (LcdDisplay_GetConfig).
+* @return void
+******************************************************************************/
+extern void
+DioStub_SetConfig(const LcdDisplayConfig_t* const Config)
+{
+  gConfig = Config;
+  gHalf = 0;
+  gReadHalf = 0;
+}
+
+/******************************************************************************
+* Function : DioStub_SetLatch()
+*//**
+* \b Description: Set the callback of the latched bytes<br/>
+* @param Latch The callback, 0 to stop reporting.
+* @return void
+******************************************************************************/
+extern void
+DioStub_SetLatch(const DioStubLatch_t Latch)
+{
+  gLatch = Latch;
+  gHalf = 0;
+}
+
+/******************************************************************************
+* Function : DioStub_SetRead()
+*//**
+* \b Description: Set the callback of the read bytes. A read needs an R/W
+* channel of its own.<br/>
+* @param Read The callback, 0 to leave the data channels as they are.
+* @return void
+******************************************************************************/
+extern void
+DioStub_SetRead(const DioStubRead_t Read)
+{
+  gReader = Read;
+  gReadHalf = 0;
+}
+
+/******************************************************************************
+* Function : DioStub_SetPort()
+*//**
+* \b Description: Set the register standing for the first port: each write
+* to it sets the channels of the port (bit n for channel n)<br/>
+* @param Port The register, 0 to stop decoding it.
+* @return void
+******************************************************************************/
+extern void
+DioStub_SetPort(volatile uint8_t* const Port)
+{
+  gPort = Port;
+}
+
+extern void
+Dio_Init(const DioConfig_t * const Config)
+{
+  (void)Config;
+}
+
+extern DioState_t
+Dio_ChannelRead(DioChannel_t Channel)
+{
+  return gPins[Channel];
+}
+
+/******************************************************************************
+* Function : Dio_ChannelWrite()
+*//**
+* \b Description: Set a channel. A falling edge of the enable channel of 
+* LCD_DISPLAY_0 latches a nibble of the data channels. While its R/W 
+* channel is high, a rising edge drives a nibble of the read byte on the 
+* data channels instead.<br/>
+* @param Channel The channel.
+* @param State The state.
+* @return void
+******************************************************************************/
+extern void
+Dio_ChannelWrite(DioChannel_t Channel, DioState_t State)
+{
+  const LcdDisplayConfig_t* const Config = (gConfig != 0x00) ? gConfig :
+   &LcdDisplay_GetConfig()[0];
+  const uint8_t Reading = Config->Rw != Config->En &&
+   gPins[Config->Rw] == DIO_STATE_HIGH;
+  uint8_t Nibble;
+  uint8_t Bit;
+
+  if(Reading == 1 && Channel == Config->En && gReader != 0x00 &&
+     gPins[Channel] == DIO_STATE_LOW && State == DIO_STATE_HIGH)
+    {
+      if(gReadHalf == 0)
+        {
+          gRead = gReader(gPins[Config->Rs] == DIO_STATE_HIGH);
+          Nibble = gRead >> 4;
+        }
+      else
+        {
+          Nibble = gRead & 0x0F;
+        }
+
+      gReadHalf ^= 1;
+      for(Bit = 0; Bit < 4; Bit++)
+        {
+          gPins[Config->Data[Bit]] = ((Nibble >> Bit) & 1) ? DIO_STATE_HIGH :
+           DIO_STATE_LOW;
+        }
+    }
+  else if(Reading == 0 && Channel == Config->En &&
+          gPins[Channel] == DIO_STATE_HIGH && State == DIO_STATE_LOW)
+    {
+      Nibble = 0;
+      for(Bit = 0; Bit < 4; Bit++)
+        {
+          Nibble |= (uint8_t)((gPins[Config->Data[Bit]] == DIO_STATE_HIGH)
+           << Bit);
+        }
+
+      if(gHalf == 0)
+        {
+          gHigh = Nibble;
+          gHalf = 1;
+        }
+      else
+        {
+          gHalf = 0;
+          if(gLatch != 0x00)
+            {
+              gLatch(gPins[Config->Rs] == DIO_STATE_HIGH,
+               (uint8_t)((gHigh << 4) | Nibble));
+            }
+        }
+    }
+
+  gPins[Channel] = State;
+}
+
+extern void
+Dio_SetChannelDirection(DioChannel_t Channel, DioDirection_t Direction)
+{
+  (void)Channel;
+  (void)Direction;
+}
+
+extern void
+Dio_RegisterWrite(uint8_t volatile * const Address, uint8_t Value)
+{
+  uint8_t Bit;
+
+  *Address = Value;
+
+  if(Address != gPort) return;
+
+  for(Bit = 0; Bit < DIO_CHANNELS_PER_PORT && Bit < DIO_CHANNEL_MAX; Bit++)
+    {
+      Dio_ChannelWrite((DioChannel_t)Bit,
+       (Value & (1 << Bit)) ? DIO_STATE_HIGH : DIO_STATE_LOW);
+    }
+}
+
+extern const volatile uint8_t
+Dio_RegisterRead(const volatile uint8_t * const Address)
+{
+  return *Address;
+}
+/*****************************End of File ************************************/
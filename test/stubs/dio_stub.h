@@ -0,0 +1,50 @@
+/**
+ * @file dio_stub.h
+ * @author Mohamed Hassanin Mohamed
+ * @brief A host stub of the dio interface. It decodes the 4-bit HD44780 bus
+ * driven by the dio transport of LCD_DISPLAY_0 and reports every latched 
+ * byte. A port register can stand for the first port, so the transports 
+ * writing whole ports are decoded too. When the display has an R/W channel,
+ * the reads are answered by a callback.
+ * @version 0.1
+ * @date 2021-04-22
+ */
+#ifndef DIO_STUB_H_
+#define DIO_STUB_H_
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "lcd_display_cfg.h"
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief a callback invoked for each byte latched by the display: Rs is 1
+ * for a character and 0 for a command
+ */
+typedef void (*DioStubLatch_t)(uint8_t Rs, uint8_t Byte);
+
+/**
+ * @brief a callback invoked for each byte read by the display: Rs is 1 for
+ * a character and 0 for the status
+ */
+typedef uint8_t (*DioStubRead_t)(uint8_t Rs);
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern void DioStub_SetConfig(const LcdDisplayConfig_t* const Config);
+extern void DioStub_SetLatch(const DioStubLatch_t Latch);
+extern void DioStub_SetRead(const DioStubRead_t Read);
+extern void DioStub_SetPort(volatile uint8_t* const Port);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end DIO_STUB_H_ */
+/*****************************End of File ************************************/
@@ -0,0 +1,252 @@
+/**
+ * @file hd44780_model.c
+ * @author Mohamed Hassanin
+ * @brief A host model of an HD44780 controller for the tests. It's fed the
+ * bytes latched by a stub transport and keeps the DDRAM, the CGRAM and the
+ * address counter the way the controller does (2-line mode, the address
+ * counter incremented), for each controller of a 40x4 panel.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "hd44780_model.h"
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HD44780_MODEL_CLEAR 0x01 /**< the clear display command */
+#define HD44780_MODEL_HOME 0x02 /**< the return home command (bit 0 unused) */
+#define HD44780_MODEL_SET_DDRAM 0x80 /**< the set DDRAM address command */
+#define HD44780_MODEL_SET_CGRAM 0x40 /**< the set CGRAM address command */
+#define HD44780_MODEL_LINE_END 0x28 /**< the addresses of a line */
+#define HD44780_MODEL_LINE_1 0x40 /**< the address of the second line */
+/******************************************************************************
+ * Functions Prototypes
+ ******************************************************************************/
+static void Hd44780Model_Advance(Hd44780Model_t* const Model);
+/******************************************************************************
+ * Module variable definitions
+ ******************************************************************************/
+/**
+ * @brief the state of each controller
+ */
+static Hd44780Model_t gModels[HD44780_MODEL_CTRL_MAX];
+/******************************************************************************
+ * Functions definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Hd44780Model_Reset()
+*//**
+* \b Description: Clear the DDRAM, the CGRAM and the counters of all the
+* controllers<br/>
+* @return void
+******************************************************************************/
+extern void
+Hd44780Model_Reset(void)
+{
+  Hd44780Model_t* Model;
+  uint8_t Ctrl;
+  uint8_t i;
+
+  for(Ctrl = 0; Ctrl < HD44780_MODEL_CTRL_MAX; Ctrl++)
+    {
+      Model = &gModels[Ctrl];
+
+      for(i = 0; i < HD44780_MODEL_DDRAM; i++)
+        {
+          Model->Ddram[i] = HD44780_MODEL_BLANK;
+        }
+
+      for(i = 0; i < HD44780_MODEL_CGRAM; i++)
+        {
+          Model->Cgram[i] = 0;
+        }
+
+      Model->Address = 0;
+      Model->InCgram = 0;
+      Model->Commands = 0;
+      Model->Chars = 0;
+    }
+}
+
+/******************************************************************************
+* Function : Hd44780Model_Latch()
+*//**
+* \b Description: Latch a byte into the first controller. It fits 
+* DioStubLatch_t so it can be handed to the stubs as it is.<br/>
+* @param Rs 1 for a character, 0 for a command.
+* @param Byte The latched byte.
+* @return void
+******************************************************************************/
+extern void
+Hd44780Model_Latch(uint8_t Rs, uint8_t Byte)
+{
+  Hd44780Model_LatchCtrl(0, Rs, Byte);
+}
+
+/******************************************************************************
+* Function : Hd44780Model_LatchCtrl()
+*//**
+* \b Description: Latch a byte into a controller<br/>
+* @param Ctrl The controller (the enable line that fell).
+* @param Rs 1 for a character, 0 for a command.
+* @param Byte The latched byte.
+* @return void
+******************************************************************************/
+extern void
+Hd44780Model_LatchCtrl(uint8_t Ctrl, uint8_t Rs, uint8_t Byte)
+{
+  Hd44780Model_t* const Model = &gModels[Ctrl % HD44780_MODEL_CTRL_MAX];
+  uint8_t i;
+
+  if(Rs == 1)
+    {
+      Model->Chars++;
+
+      if(Model->InCgram == 1)
+        {
+          Model->Cgram[Model->Address] = Byte;
+        }
+      else
+        {
+          Model->Ddram[Model->Address] = Byte;
+        }
+
+      Hd44780Model_Advance(Model);
+      return;
+    }
+
+  Model->Commands++;
+
+  if(Byte & HD44780_MODEL_SET_DDRAM)
+    {
+      Model->Address = Byte & (HD44780_MODEL_DDRAM - 1);
+      Model->InCgram = 0;
+    }
+  else if(Byte & HD44780_MODEL_SET_CGRAM)
+    {
+      Model->Address = Byte & (HD44780_MODEL_CGRAM - 1);
+      Model->InCgram = 1;
+    }
+  else if((Byte & ~1) == HD44780_MODEL_HOME || Byte == HD44780_MODEL_CLEAR)
+    {
+      if(Byte == HD44780_MODEL_CLEAR)
+        {
+          for(i = 0; i < HD44780_MODEL_DDRAM; i++)
+            {
+              Model->Ddram[i] = HD44780_MODEL_BLANK;
+            }
+        }
+
+      Model->Address = 0;
+      Model->InCgram = 0;
+    }
+}
+
+/******************************************************************************
+* Function : Hd44780Model_Read()
+*//**
+* \b Description: Read a byte from the first controller: the status or the
+* character at the address counter, which then moves on. It fits 
+* DioStubRead_t so it can be handed to the stubs as it is.<br/>
+* @param Rs 1 for a character, 0 for the status.
+* @return uint8_t the byte read (the busy flag is never set)
+******************************************************************************/
+extern uint8_t
+Hd44780Model_Read(uint8_t Rs)
+{
+  Hd44780Model_t* const Model = &gModels[0];
+  uint8_t Byte;
+
+  if(Rs == 0) return Model->Address;
+
+  Byte = (Model->InCgram == 1) ? Model->Cgram[Model->Address] :
+   Model->Ddram[Model->Address];
+  Hd44780Model_Advance(Model);
+
+  return Byte;
+}
+
+/******************************************************************************
+* Function : Hd44780Model_Advance()
+*//**
+* \b Description: Utility function to move the address counter to the next
+* character<br/>
+* @param Model The controller.
+* @return void
+******************************************************************************/
+static void
+Hd44780Model_Advance(Hd44780Model_t* const Model)
+{
+  if(Model->InCgram == 1)
+    {
+      Model->Address = (Model->Address + 1) % HD44780_MODEL_CGRAM;
+      return;
+    }
+
+  Model->Address++;
+
+  //the lines are 40 addresses each, the second one starts at 0x40
+  if(Model->Address == HD44780_MODEL_LINE_END)
+    {
+      Model->Address = HD44780_MODEL_LINE_1;
+    }
+  else if(Model->Address == HD44780_MODEL_LINE_1 + HD44780_MODEL_LINE_END)
+    {
+      Model->Address = 0;
+    }
+}
+
+/******************************************************************************
+* Function : Hd44780Model_Get()
+*//**
+* \b Description: Get the state of the first controller<br/>
+* @return const Hd44780Model_t* the state
+******************************************************************************/
+extern const Hd44780Model_t*
+Hd44780Model_Get(void)
+{
+  return &gModels[0];
+}
+
+/******************************************************************************
+* Function : Hd44780Model_GetCtrl()
+*//**
+* \b Description: Get the state of a controller<br/>
+* @param Ctrl The controller.
+* @return const Hd44780Model_t* the state
+******************************************************************************/
+extern const Hd44780Model_t*
+Hd44780Model_GetCtrl(uint8_t Ctrl)
+{
+  return &gModels[Ctrl % HD44780_MODEL_CTRL_MAX];
+}
+
+/******************************************************************************
+* Function : Hd44780Model_Match()
+*//**
+* \b Description: Check the DDRAM of the first controller from an address
+* against a text<br/>
+* @param Address The DDRAM address of the first character.
+* @param Text The text, 0 terminated.
+* @return uint8_t 1 if the DDRAM holds the text, 0 otherwise
+******************************************************************************/
+extern uint8_t
+Hd44780Model_Match(const uint8_t Address, const char* const Text)
+{
+  const Hd44780Model_t* const Model = &gModels[0];
+  uint8_t i;
+
+  for(i = 0; Text[i] != '\0'; i++)
+    {
+      if(Address + i >= HD44780_MODEL_DDRAM ||
+         Model->Ddram[Address + i] != (uint8_t)Text[i])
+        {
+          return 0;
+        }
+    }
+
+  return 1;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,60 @@
+/**
+ * @file hd44780_model.h
+ * @author Mohamed Hassanin
+ * @brief A host model of an HD44780 controller for the tests. It's fed the
+ * bytes latched by a stub transport and keeps the DDRAM, the CGRAM and the
+ * address counter the way the controller does, for each controller of a 
+ * 40x4 panel.
+ * @version 0.1
+ * @date 2021-04-25
+ */
+#ifndef HD44780_MODEL_H_
+#define HD44780_MODEL_H_
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+/******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define HD44780_MODEL_DDRAM 0x80 /**< the DDRAM bytes (addresses 0-0x7F) */
+#define HD44780_MODEL_CGRAM 0x40 /**< the CGRAM bytes */
+#define HD44780_MODEL_BLANK 0x20 /**< the DDRAM after a clear */
+#define HD44780_MODEL_CTRL_MAX 2 /**< the controllers of a panel */
+/******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/**
+ * @brief the state of the controller
+ */
+typedef struct
+{
+  uint8_t Ddram[HD44780_MODEL_DDRAM]; /**< indexed by the DDRAM address */
+  uint8_t Cgram[HD44780_MODEL_CGRAM]; /**< indexed by the CGRAM address */
+  uint8_t Address; /**< the address counter */
+  uint8_t InCgram; /**< 1 if the address counter points into the CGRAM */
+  uint32_t Commands; /**< the commands latched */
+  uint32_t Chars; /**< the characters/rows latched */
+} Hd44780Model_t;
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern void Hd44780Model_Reset(void);
+extern void Hd44780Model_Latch(uint8_t Rs, uint8_t Byte);
+extern void Hd44780Model_LatchCtrl(uint8_t Ctrl, uint8_t Rs, uint8_t Byte);
+extern uint8_t Hd44780Model_Read(uint8_t Rs);
+extern const Hd44780Model_t* Hd44780Model_Get(void);
+extern const Hd44780Model_t* Hd44780Model_GetCtrl(uint8_t Ctrl);
+extern uint8_t Hd44780Model_Match(const uint8_t Address,
+                                  const char* const Text);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end HD44780_MODEL_H_ */
+/*****************************End of File ************************************/